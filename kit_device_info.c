@@ -112,6 +112,106 @@ const opcode_cmd_string_t ta_device_opcode_cmd_string[] =
     {ATCA_TA_WRITE, write_string},
 };
 
+/*
+    Command execution times, the first entry of the opcode whose mode bits match is
+    used so the mode specific entries come first. The maximum times are the
+    datasheet ones, the typical times the ones the commands usually complete in.
+ */
+const opcode_execution_time_t eccx08_execution_time[] =
+{
+    {ATCA_AES,          0x00, 0x00,   1000,  27},
+    {ATCA_CHECKMAC,     0x00, 0x00,   5000,  40},
+    {ATCA_COUNTER,      0x00, 0x00,   5000,  25},
+    {ATCA_DERIVE_KEY,   0x00, 0x00,   2000,  50},
+    {ATCA_ECDH,         0x00, 0x00,  38000,  60},
+    {ATCA_GENDIG,       0x00, 0x00,   5000,  25},
+    {ATCA_GENKEY,       GENKEY_MODE_DIGEST, GENKEY_MODE_DIGEST,   5000, 115},
+    {ATCA_GENKEY,       GENKEY_MODE_PRIVATE, GENKEY_MODE_PRIVATE, 59000, 115},
+    {ATCA_GENKEY,       0x00, 0x00,  45000, 115},
+    {ATCA_HMAC,         0x00, 0x00,  15000,  23},
+    {ATCA_INFO,         0x00, 0x00,    500,   5},
+    {ATCA_KDF,          0x00, 0x00,  10000, 165},
+    {ATCA_LOCK,         0x00, 0x00,  10000,  35},
+    {ATCA_MAC,          0x00, 0x00,   5000,  55},
+    {ATCA_NONCE,        0x00, 0x00,   1000,  20},
+    {ATCA_PAUSE,        0x00, 0x00,    500,   3},
+    {ATCA_PRIVWRITE,    0x00, 0x00,  10000,  50},
+    {ATCA_RANDOM,       0x00, 0x00,   1000,  23},
+    {ATCA_READ,         0x00, 0x00,    500,   5},
+    {ATCA_SECUREBOOT,   0x00, 0x00,  28000,  80},
+    {ATCA_SELFTEST,     0x00, 0x00,  80000, 250},
+    {ATCA_SIGN,         0x00, 0x00,  43000,  60},
+    {ATCA_SHA,          0x00, 0x00,   1000,  36},
+    {ATCA_UPDATE_EXTRA, 0x00, 0x00,   8000,  10},
+    {ATCA_VERIFY,       0x00, 0x00,  38000,  72},
+    {ATCA_WRITE,        0x00, 0x00,   7000,  45},
+};
+
+const opcode_execution_time_t sha20x_execution_time[] =
+{
+    {ATCA_CHECKMAC,     0x00, 0x00,  12000,  38},
+    {ATCA_DERIVE_KEY,   0x00, 0x00,  14000,  62},
+    {ATCA_GENDIG,       0x00, 0x00,  11000,  43},
+    {ATCA_HMAC,         0x00, 0x00,  27000,  69},
+    {ATCA_INFO,         0x00, 0x00,    500,   2},
+    {ATCA_LOCK,         0x00, 0x00,   5000,  24},
+    {ATCA_MAC,          0x00, 0x00,  12000,  35},
+    {ATCA_NONCE,        NONCE_MODE_MASK, NONCE_MODE_PASSTHROUGH, 1000, 60},
+    {ATCA_NONCE,        0x00, 0x00,  22000,  60},
+    {ATCA_PAUSE,        0x00, 0x00,    500,   2},
+    {ATCA_RANDOM,       0x00, 0x00,  11000,  50},
+    {ATCA_READ,         0x00, 0x00,    500,   5},
+    {ATCA_SHA,          0x00, 0x00,  11000,  22},
+    {ATCA_UPDATE_EXTRA, 0x00, 0x00,   8000,  12},
+    {ATCA_WRITE,        0x00, 0x00,   4000,  42},
+};
+
+const opcode_execution_time_t ta10x_execution_time[] =
+{
+    {ATCA_TA_AES,        0x00, 0x00,   1000,   10},
+    {ATCA_TA_AUTHORIZE,  0x00, 0x00,   5000,   50},
+    {ATCA_TA_COUNTER,    0x00, 0x00,   2000,   20},
+    {ATCA_TA_CREATE,     0x00, 0x00,   5000,   50},
+    {ATCA_TA_DELETE,     0x00, 0x00,   5000,   50},
+    {ATCA_TA_DEVUPDATE,  0x00, 0x00,  50000, 1500},
+    {ATCA_TA_ECDH,       0x00, 0x00,  25000,  100},
+    {ATCA_TA_EXPORT,     0x00, 0x00,   5000,  100},
+    {ATCA_TA_FCCONFIG,   0x00, 0x00,   5000,   50},
+    {ATCA_TA_IMPORT,     0x00, 0x00,   5000,  100},
+    {ATCA_TA_INFO,       0x00, 0x00,   1000,   10},
+    {ATCA_TA_KDF,        0x00, 0x00,   5000,  100},
+    {ATCA_TA_KEYGEN,     0x00, 0x00,  30000, 2000},
+    {ATCA_TA_LOCK,       0x00, 0x00,   5000,   50},
+    {ATCA_TA_MAC,        0x00, 0x00,   2000,   50},
+    {ATCA_TA_MANAGECERT, 0x00, 0x00,  40000,  500},
+    {ATCA_TA_POWER,      0x00, 0x00,   1000,   10},
+    {ATCA_TA_RANDOM,     0x00, 0x00,   1000,   20},
+    {ATCA_TA_READ,       0x00, 0x00,   2000,   50},
+    {ATCA_TA_RSAENC,     0x00, 0x00,  10000,  200},
+    {ATCA_TA_SECUREBOOT, 0x00, 0x00,  20000,  200},
+    {ATCA_TA_SELFTEST,   0x00, 0x00, 100000, 1000},
+    {ATCA_TA_SEQUENCE,   0x00, 0x00,   5000,  100},
+    {ATCA_TA_SHA,        0x00, 0x00,   1000,   20},
+    {ATCA_TA_SIGN,       0x00, 0x00,  25000,  200},
+    {ATCA_TA_VERIFY,     0x00, 0x00,  25000,  200},
+    {ATCA_TA_WRITE,      0x00, 0x00,   5000,  100},
+};
+
+const opcode_execution_time_t ecc204_execution_time[] =
+{
+    {ECC204_COUNTER,     0x00, 0x00,  10000, ECC204_COUNTER_EXEC_DELAY},
+    {ECC204_DELETE,      0x00, 0x00, 150000, ECC204_DELETE_EXEC_DELAY},
+    {ECC204_GENKEY,      0x00, 0x00, 300000, ECC204_GENKEY_EXEC_DELAY},
+    {ECC204_INFO,        0x00, 0x00,   5000, ECC204_INFO_EXEC_DELAY},
+    {ECC204_LOCK,        0x00, 0x00,  40000, ECC204_LOCK_EXEC_DELAY},
+    {ECC204_NONCE,       0x00, 0x00,  80000, ECC204_NONCE_EXEC_DELAY},
+    {ECC204_READ,        0x00, 0x00,  20000, ECC204_READ_EXEC_DELAY},
+    {ECC204_SELFTEST,    0x00, 0x00, 400000, ECC204_SELFTEST_EXEC_DELAY},
+    {ECC204_SHA,         0x00, 0x00,  40000, ECC204_SHA_EXEC_DELAY},
+    {ECC204_SIGN,        0x00, 0x00, 300000, ECC204_SIGN_EXEC_DELAY},
+    {ECC204_WRITE,       0x00, 0x00,  40000, ECC204_WRITE_EXEC_DELAY},
+};
+
 const device_cmd_string_t device_cmd_string_info[] =
 {
     {DEVICE_TYPE_SHA204, sha204_string},
@@ -443,6 +543,140 @@ uint16_t get_ecc204_opcode_execution_delay(uint8_t opcode)
     }
 }
 
+uint16_t get_device_watchdog_time(device_type_t device_type)
+{
+    switch (device_type)
+    {
+    case DEVICE_TYPE_SHA204:
+        /* fall-through */
+    case DEVICE_TYPE_SHA204A:
+        /* fall-through */
+    case DEVICE_TYPE_SHA206A:
+        /* fall-through */
+    case DEVICE_TYPE_ECC108:
+        /* fall-through */
+    case DEVICE_TYPE_ECC108A:
+        /* fall-through */
+    case DEVICE_TYPE_ECC508A:
+        /* fall-through */
+    case DEVICE_TYPE_ECC608A:
+        /* fall-through */
+    case DEVICE_TYPE_ECC608B:
+        return ECC_WATCHDOG_TIME_MS;
+        break;
+    default:
+        return 0;
+        break;
+    }
+}
+
+const opcode_execution_time_t* get_device_execution_time(device_type_t device_type, uint8_t opcode, uint8_t mode)
+{
+    const opcode_execution_time_t* execution_time;
+    uint8_t execution_time_count;
+    uint8_t index;
+
+    switch (device_type)
+    {
+    case DEVICE_TYPE_SHA204:
+        /* fall-through */
+    case DEVICE_TYPE_SHA204A:
+        /* fall-through */
+    case DEVICE_TYPE_SHA206A:
+        execution_time = sha20x_execution_time;
+        execution_time_count = sizeof(sha20x_execution_time)/sizeof(sha20x_execution_time[0]);
+        break;
+    case DEVICE_TYPE_ECC108:
+        /* fall-through */
+    case DEVICE_TYPE_ECC108A:
+        /* fall-through */
+    case DEVICE_TYPE_ECC508A:
+        /* fall-through */
+    case DEVICE_TYPE_ECC608A:
+        /* fall-through */
+    case DEVICE_TYPE_ECC608B:
+        execution_time = eccx08_execution_time;
+        execution_time_count = sizeof(eccx08_execution_time)/sizeof(eccx08_execution_time[0]);
+        break;
+    case DEVICE_TYPE_TA100:
+        /* fall-through */
+    case DEVICE_TYPE_TA101:
+        execution_time = ta10x_execution_time;
+        execution_time_count = sizeof(ta10x_execution_time)/sizeof(ta10x_execution_time[0]);
+        break;
+    case DEVICE_TYPE_ECC204:
+        /* fall-through */
+    case DEVICE_TYPE_TA010:
+        /* fall-through */
+    case DEVICE_TYPE_ECC206:
+        /* fall-through */
+    case DEVICE_TYPE_RNG90:
+        /* fall-through */
+    case DEVICE_TYPE_SHA104:
+        /* fall-through */
+    case DEVICE_TYPE_SHA105:
+        /* fall-through */
+    case DEVICE_TYPE_SHA106:
+        execution_time = ecc204_execution_time;
+        execution_time_count = sizeof(ecc204_execution_time)/sizeof(ecc204_execution_time[0]);
+        break;
+    default:
+        return NULL;
+        break;
+    }
+
+    for (index = 0; index < execution_time_count; index++)
+    {
+        if ((execution_time[index].opcode == opcode) &&
+            ((mode & execution_time[index].mode_mask) == execution_time[index].mode))
+        {
+            return &execution_time[index];
+        }
+    }
+
+    return NULL;
+}
+
+uint16_t get_device_wake_delay(device_type_t device_type, interface_id_t bus_type)
+{
+    if (bus_type == DEVKIT_IF_SPI)
+    {
+        return SPI_WAKE_DELAY_US;
+    }
+
+    switch (device_type)
+    {
+    case DEVICE_TYPE_SHA204:
+        /* fall-through */
+    case DEVICE_TYPE_SHA204A:
+        return SHA204_WAKE_DELAY_US;
+        break;
+    case DEVICE_TYPE_TA100:
+        /* fall-through */
+    case DEVICE_TYPE_TA101:
+        return TA10X_WAKE_DELAY_US;
+        break;
+    case DEVICE_TYPE_ECC204:
+        /* fall-through */
+    case DEVICE_TYPE_TA010:
+        /* fall-through */
+    case DEVICE_TYPE_ECC206:
+        /* fall-through */
+    case DEVICE_TYPE_RNG90:
+        /* fall-through */
+    case DEVICE_TYPE_SHA104:
+        /* fall-through */
+    case DEVICE_TYPE_SHA105:
+        /* fall-through */
+    case DEVICE_TYPE_SHA106:
+        return ECC204_WAKE_DELAY_US;
+        break;
+    default:
+        return ECCX08_WAKE_DELAY_US;
+        break;
+    }
+}
+
 bool check_idle_support(device_type_t device_type)
 {
     switch (device_type)
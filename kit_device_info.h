@@ -339,6 +339,20 @@ typedef struct
 /** @} */
 
 
+/** \name Device wake delay, from the end of the wake pulse to the wake response (tWHI)
+ * @{ */
+#define SHA204_WAKE_DELAY_US                    ((uint16_t)2500) //!< SHA204 and SHA204A
+#define ECCX08_WAKE_DELAY_US                    ((uint16_t)1500) //!< ECC108, ECC508A, ECC608, SHA206A and AES132
+#define ECC204_WAKE_DELAY_US                    ((uint16_t)1500) //!< ECC204, ECC206, TA010, SHA10x and RNG90
+#define TA10X_WAKE_DELAY_US                     ((uint16_t)0)    //!< TA100 and TA101, awake while powered
+#define SPI_WAKE_DELAY_US                       ((uint16_t)0)    //!< The SPI devices respond to the first read
+/** @} */
+
+/** \name Device watchdog, the device goes to sleep this long after its wake
+ * @{ */
+#define ECC_WATCHDOG_TIME_MS                    ((uint16_t)1300) //!< ECCx08, SHA20x and SHA206A watchdog
+/** @} */
+
 /** \name ECC204 Command execution delay
  * @{ */
 #define ECC204_COUNTER_EXEC_DELAY               ((uint16_t)20)   //!< Counter command op-code
@@ -433,6 +447,8 @@ typedef enum
     MICROBUS_HEADER,
 } ext_header;
 
+struct kit_hal_interface;
+
 //! information about a discovered device
 typedef struct
 {
@@ -456,6 +472,9 @@ typedef struct
 
     ext_header header;
 
+    //! HAL of the device bus, set when discovered
+    const struct kit_hal_interface *hal;
+
 } device_info_t;
 
 typedef struct
@@ -470,6 +489,15 @@ typedef struct
    const char* device_string;
 }device_cmd_string_t;
 
+typedef struct
+{
+   uint8_t opcode;
+   uint8_t mode_mask;          //!< The mode bits the entry depends on, 0 for any mode
+   uint8_t mode;               //!< The mode bits value of the entry
+   uint32_t typical_time_us;   //!< The time the command usually takes, in microseconds
+   uint16_t max_time_ms;       //!< The longest time the command takes, in milliseconds
+}opcode_execution_time_t;
+
 
 /** \brief The function return device type based on device revision number (Crypto device)
  *
@@ -550,6 +578,45 @@ uint8_t get_eccx08_response_size(uint8_t *command);
  */
 uint16_t get_ecc204_opcode_execution_delay(uint8_t opcode);
 
+/** \brief The function return the device wake delay, before its wake response can be read
+ *
+ *  \param[in]    device_type          references to device type
+ *                bus_type             references to device interface
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return wake delay, in microseconds
+ */
+uint16_t get_device_wake_delay(device_type_t device_type, interface_id_t bus_type);
+
+/** \brief The function return the device watchdog time
+ *
+ *  \param[in]    device_type          references to device type
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return watchdog time in milliseconds, 0 when the device has no watchdog to track
+ */
+uint16_t get_device_watchdog_time(device_type_t device_type);
+
+/** \brief The function return the command execution time of a device
+ *
+ *  \param[in]    device_type          references to device type
+ *                opcode               references to device command opcode
+ *                mode                 references to device command mode (param1)
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return command execution time, NULL when the command is not in the device table
+ */
+const opcode_execution_time_t* get_device_execution_time(device_type_t device_type, uint8_t opcode, uint8_t mode);
+
 /** \brief The function return device type
  *
  *  \param[in]    dev_rev             references to device revision
@@ -31,74 +31,123 @@
  */
 
 #include "kit_hal_interface.h"
+#ifdef KIT_HAL_PROFILE
+#include "kit_protocol/kit_protocol_profile.h"
+#endif
 
 static device_info_t device_info[MAX_DISCOVER_DEVICES];
+// Device index + 1 of the first discovered device of each address (0 when none)
+static uint8_t device_address_index[UINT8_MAX + 1];
+// Device index + 1 of the next discovered device with the same address (0 when none)
+static uint8_t device_next_index[MAX_DISCOVER_DEVICES];
+// The HAL of each compiled bus, they all stay initialized once discovered
+#ifdef KIT_HAL_I2C
+static const struct kit_hal_interface g_kit_hal_i2c =
+{
+    .init = &hal_i2c_init,
+    .deinit = &hal_i2c_deinit,
+    .discover = &hal_i2c_discover,
+    .wake = &hal_i2c_wake,
+    .sleep = &hal_i2c_sleep,
+    .idle = &hal_i2c_idle,
+    .send = &hal_i2c_send,
+    .receive = &hal_i2c_receive,
+    .talk = &hal_i2c_talk,
+#ifdef KIT_HAL_TALK_ASYNC
+    .talk_start = &hal_i2c_talk_start,
+    .talk_complete = &hal_i2c_talk_complete,
+#endif
+};
+#endif
+
+#ifdef KIT_HAL_SWI
+static const struct kit_hal_interface g_kit_hal_swi =
+{
+    .init = &hal_swi_init,
+    .deinit = &hal_swi_deinit,
+    .discover = &hal_swi_discover,
+    .wake = &hal_swi_wake,
+    .sleep = &hal_swi_sleep,
+    .idle = &hal_swi_idle,
+    .send = &hal_swi_send,
+    .receive = &hal_swi_receive,
+    .talk = &hal_swi_talk,
+#ifdef KIT_HAL_TALK_ASYNC
+    .talk_start = &hal_swi_talk_start,
+    .talk_complete = &hal_swi_talk_complete,
+#endif
+};
+#endif
+
+#ifdef KIT_HAL_SPI
+static const struct kit_hal_interface g_kit_hal_spi =
+{
+    .init = &hal_spi_init,
+    .deinit = &hal_spi_deinit,
+    .discover = &hal_spi_discover,
+    .wake = &hal_spi_wake,
+    .sleep = &hal_spi_sleep,
+    .idle = &hal_spi_idle,
+    .send = &hal_spi_send,
+    .receive = &hal_spi_receive,
+    .talk = &hal_spi_talk,
+#ifdef KIT_HAL_TALK_ASYNC
+    .talk_start = &hal_spi_talk_start,
+    .talk_complete = &hal_spi_talk_complete,
+#endif
+};
+#endif
+
+#ifdef KIT_HAL_SWI2
+static const struct kit_hal_interface g_kit_hal_gpio =
+{
+    .init = &hal_gpio_init,
+    .deinit = &hal_gpio_deinit,
+    .discover = &hal_gpio_discover,
+    .wake = &hal_gpio_wake,
+    .sleep = &hal_gpio_sleep,
+    .idle = &hal_gpio_idle,
+    .send = &hal_gpio_send,
+    .receive = &hal_gpio_receive,
+    .talk = &hal_gpio_talk,
+#ifdef KIT_HAL_TALK_ASYNC
+    .talk_start = &hal_gpio_talk_start,
+    .talk_complete = &hal_gpio_talk_complete,
+#endif
+};
+#endif
+
 struct kit_hal_interface g_kit_hal_interface;
+const struct kit_hal_interface *g_kit_hal_selected;
 static const char *ext_header_string[] = {"EXT1 ", "EXT2 ", "EXT3 ", "MICROBUS"};
 
-enum kit_protocol_status hal_iface_init(interface_id_t iface)
+const struct kit_hal_interface *get_hal_interface(interface_id_t iface)
 {
-    enum kit_protocol_status status = KIT_STATUS_INVALID_PARAM;
+    const struct kit_hal_interface *hal = NULL;
 
     switch (iface)
     {
     case DEVKIT_IF_I2C:
 #ifdef KIT_HAL_I2C
-        g_kit_hal_interface.init = &hal_i2c_init;
-        g_kit_hal_interface.deinit = &hal_i2c_deinit;
-        g_kit_hal_interface.discover = &hal_i2c_discover;
-        g_kit_hal_interface.wake = &hal_i2c_wake;
-        g_kit_hal_interface.idle = &hal_i2c_idle;
-        g_kit_hal_interface.sleep = &hal_i2c_sleep;
-        g_kit_hal_interface.talk = &hal_i2c_talk;
-        g_kit_hal_interface.send = &hal_i2c_send;
-        g_kit_hal_interface.receive = &hal_i2c_receive;
-        status = KIT_STATUS_SUCCESS;
+        hal = &g_kit_hal_i2c;
 #endif
         break;
 
     case DEVKIT_IF_SWI:
 #ifdef KIT_HAL_SWI
-        g_kit_hal_interface.init = &hal_swi_init;
-        g_kit_hal_interface.deinit = &hal_swi_deinit;
-        g_kit_hal_interface.discover = &hal_swi_discover;
-        g_kit_hal_interface.wake = &hal_swi_wake;
-        g_kit_hal_interface.idle = &hal_swi_idle;
-        g_kit_hal_interface.sleep = &hal_swi_sleep;
-        g_kit_hal_interface.talk = &hal_swi_talk;
-        g_kit_hal_interface.send = &hal_swi_send;
-        g_kit_hal_interface.receive = &hal_swi_receive;
-        status = KIT_STATUS_SUCCESS;
+        hal = &g_kit_hal_swi;
 #endif
         break;
 
     case DEVKIT_IF_SPI:
 #ifdef KIT_HAL_SPI
-        g_kit_hal_interface.init = &hal_spi_init;
-        g_kit_hal_interface.deinit = &hal_spi_deinit;
-        g_kit_hal_interface.discover = &hal_spi_discover;
-        g_kit_hal_interface.wake = &hal_spi_wake;
-        g_kit_hal_interface.idle = &hal_spi_idle;
-        g_kit_hal_interface.sleep = &hal_spi_sleep;
-        g_kit_hal_interface.talk = &hal_spi_talk;
-        g_kit_hal_interface.send = &hal_spi_send;
-        g_kit_hal_interface.receive = &hal_spi_receive;
-        status = KIT_STATUS_SUCCESS;
+        hal = &g_kit_hal_spi;
 #endif
         break;
 
     case DEVKIT_IF_SWI2:
 #ifdef KIT_HAL_SWI2
-        g_kit_hal_interface.init = &hal_gpio_init;
-        g_kit_hal_interface.deinit = &hal_gpio_deinit;
-        g_kit_hal_interface.discover = &hal_gpio_discover;
-        g_kit_hal_interface.wake = &hal_gpio_wake;
-        g_kit_hal_interface.idle = &hal_gpio_idle;
-        g_kit_hal_interface.sleep = &hal_gpio_sleep;
-        g_kit_hal_interface.talk = &hal_gpio_talk;
-        g_kit_hal_interface.send = &hal_gpio_send;
-        g_kit_hal_interface.receive = &hal_gpio_receive;
-        status = KIT_STATUS_SUCCESS;
+        hal = &g_kit_hal_gpio;
 #endif
         break;
 
@@ -108,7 +157,76 @@ enum kit_protocol_status hal_iface_init(interface_id_t iface)
     default:
         break;
     }
-    return status;
+
+#ifdef KIT_HAL_PROFILE
+    // The HAL calls go through the timing shim
+    hal = kit_profile_wrap_hal(iface, hal);
+#endif
+
+    return hal;
+}
+
+/** \brief Selects the HAL used for the devices without a HAL of their own.
+ *
+ *  \param[in]    hal                   The HAL of the selected interface
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void hal_iface_select(const struct kit_hal_interface *hal)
+{
+    g_kit_hal_selected = hal;
+    g_kit_hal_interface = *hal;
+}
+
+enum kit_protocol_status hal_iface_init(interface_id_t iface)
+{
+    const struct kit_hal_interface *hal = get_hal_interface(iface);
+
+    if (hal == NULL)
+    {
+        return KIT_STATUS_INVALID_PARAM;
+    }
+
+    hal_iface_select(hal);
+
+    return KIT_STATUS_SUCCESS;
+}
+
+/** \brief Initializes the HAL of a bus and discovers its devices.
+ *
+ *  \param[in]    iface                 The bus
+ *
+ *  \param[out]   devices               The discovered devices
+ *
+ *  \param[inout] None
+ *
+ *  \return the number of discovered devices
+ */
+static uint8_t hal_iface_discover(interface_id_t iface, device_info_t *devices)
+{
+    const struct kit_hal_interface *hal = get_hal_interface(iface);
+    uint8_t device_count = 0;
+
+    if ((hal == NULL) || (hal->init == NULL) || (hal->discover == NULL))
+    {
+        return 0;
+    }
+
+    hal_iface_select(hal);
+    hal->init();
+    hal->discover(devices, &device_count);
+
+    // The devices keep the HAL of their bus, no HAL switch is needed to reach them
+    for (uint8_t device_index = 0; device_index < device_count; device_index++)
+    {
+        devices[device_index].hal = hal;
+    }
+
+    return device_count;
 }
 
 device_info_t *get_device_info(uint8_t index)
@@ -122,10 +240,32 @@ device_info_t *get_device_info(uint8_t index)
     return p_dev_info;
 }
 
+device_info_t *get_device_info_by_address(uint32_t address, interface_id_t interface)
+{
+    uint8_t index;
+
+    if (address > UINT8_MAX)
+    {
+        return NULL;
+    }
+
+    // Devices rarely share an address, the chain is usually a single device
+    for (index = device_address_index[address]; index != 0; index = device_next_index[index - 1])
+    {
+        if ((interface == DEVKIT_IF_UNKNOWN) ||
+            (device_info[index - 1].bus_type == interface) ||
+            ((interface == DEVKIT_IF_SWI) && (device_info[index - 1].bus_type == DEVKIT_IF_SWI2)))
+        {
+            return &device_info[index - 1];
+        }
+    }
+
+    return NULL;
+}
+
 interface_id_t hardware_interface_discover(void)
 {
     uint8_t total_device_count = 0;
-    uint8_t device_count = 0;
     const char *device_string;
     const char *header_string;
 
@@ -136,37 +276,30 @@ interface_id_t hardware_interface_discover(void)
     memset(device_info, 0, sizeof(device_info));
 
 #ifdef KIT_HAL_SWI
-    hal_iface_init(DEVKIT_IF_SWI);
-    g_kit_hal_interface.init();
-    g_kit_hal_interface.discover(&device_info[total_device_count], &device_count);
-    total_device_count += device_count;
-    device_count = 0;
+    total_device_count += hal_iface_discover(DEVKIT_IF_SWI, &device_info[total_device_count]);
 #endif
 
 #ifdef KIT_HAL_I2C
-    hal_iface_init(DEVKIT_IF_I2C);
-    g_kit_hal_interface.init();
-    g_kit_hal_interface.discover(&device_info[total_device_count], &device_count);
-    total_device_count += device_count;
-    device_count = 0;
+    total_device_count += hal_iface_discover(DEVKIT_IF_I2C, &device_info[total_device_count]);
 #endif
 
 #ifdef KIT_HAL_SPI
-    hal_iface_init(DEVKIT_IF_SPI);
-    g_kit_hal_interface.init();
-    g_kit_hal_interface.discover(&device_info[total_device_count], &device_count);
-    total_device_count += device_count;
-    device_count = 0;
+    total_device_count += hal_iface_discover(DEVKIT_IF_SPI, &device_info[total_device_count]);
 #endif
 
 #ifdef KIT_HAL_SWI2
-    hal_iface_init(DEVKIT_IF_SWI2);
-    g_kit_hal_interface.init();
-    g_kit_hal_interface.discover(&device_info[total_device_count], &device_count);
-    total_device_count += device_count;
-    device_count = 0;
+    total_device_count += hal_iface_discover(DEVKIT_IF_SWI2, &device_info[total_device_count]);
 #endif
 
+    // Index the discovered devices by address, the lowest device index first
+    memset(device_address_index, 0, sizeof(device_address_index));
+    memset(device_next_index, 0, sizeof(device_next_index));
+    for (uint8_t device_index = total_device_count; device_index > 0; device_index--)
+    {
+        device_next_index[device_index - 1] = device_address_index[device_info[device_index - 1].address];
+        device_address_index[device_info[device_index - 1].address] = device_index;
+    }
+
     for (uint8_t device_index = 0; device_index < total_device_count; device_index++)
     {
         switch (device_info[device_index].bus_type)
@@ -201,12 +334,8 @@ interface_id_t hardware_interface_discover(void)
 
 enum kit_protocol_status select_interface(interface_id_t interface)
 {
-    enum kit_protocol_status status;
-
-    g_kit_hal_interface.deinit();
-    status = hal_iface_init(interface);
-
-    return status;
+    // The buses stay initialized, only the HAL of the undiscovered devices follows the selection
+    return hal_iface_init(interface);
 }
 
 const char *get_header_string(ext_header header)
@@ -48,6 +48,9 @@ extern "C" {
 #endif
 
 /** \brief Standard HAL API initialize with physical interface API
+ *
+ *  \note  The buses are initialized by hardware_interface_discover, this only points
+ *         g_kit_hal_selected to the HAL of the interface
  *
  *  \param[in]    iface                 references to the interface (I2C, SWI, SPI) need to be selected
  *
@@ -59,6 +62,18 @@ extern "C" {
  */
 enum kit_protocol_status hal_iface_init(interface_id_t iface);
 
+/** \brief Function provides the HAL of an interface
+ *
+ *  \param[in]    iface                 references to the interface (I2C, SWI, SPI)
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return HAL of the interface, NULL when it is not compiled in
+ */
+const struct kit_hal_interface *get_hal_interface(interface_id_t iface);
+
 /** \brief Function provides the device information
  *
  *  \param[in]    index                 references to device index in structure
@@ -71,7 +86,25 @@ enum kit_protocol_status hal_iface_init(interface_id_t iface);
  */
 device_info_t *get_device_info(uint8_t index);
 
+/** \brief Function provides the device information of a discovered device address,
+ *         from the index built by hardware_interface_discover
+ *
+ *  \param[in]    address               references to device I2C address or selector byte
+ *                interface             references to the device interface, DEVKIT_IF_UNKNOWN for any
+ *                                      (DEVKIT_IF_SWI also matches DEVKIT_IF_SWI2 devices)
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return device information of the first matching device, NULL when not discovered
+ */
+device_info_t *get_device_info_by_address(uint32_t address, interface_id_t interface);
+
 /** \brief The function discover CryptoAuth devices attached to host
+ *
+ *  \note  Every compiled interface is initialized and stays so, each discovered
+ *         device keeps the HAL of its interface
  *
  *  \param[in]    None
  *
@@ -83,7 +116,8 @@ device_info_t *get_device_info(uint8_t index);
  */
 interface_id_t hardware_interface_discover(void);
 
-/** \brief Standard HAL API selected based on interface
+/** \brief Standard HAL API selected based on interface, for the devices which were not
+ *         discovered; no interface is initialized again
  *
  *  \param[in]    interface              references to the interface (I2C, SWI, SPI) need to be selected
  *
@@ -119,9 +153,16 @@ struct kit_hal_interface
   enum kit_protocol_status (*send)(uint32_t, uint8_t*, uint16_t *);//The function send input message command to device
   enum kit_protocol_status (*receive)(uint32_t, uint8_t*, uint16_t *);//Its a pointer that holds host interface hardware receive function
   enum kit_protocol_status (*talk)(uint32_t, uint8_t*, uint16_t *);//Its a pointer that holds host interface hardware talk function
+  enum kit_protocol_status (*talk_start)(uint32_t, uint8_t*, uint16_t *);//Optional, starts a talk command without waiting for its response
+  enum kit_protocol_status (*talk_complete)(uint32_t, uint8_t*, uint16_t *);//Optional, reads the talk response, KIT_STATUS_PENDING until the device is done
 };
 
-extern struct kit_hal_interface g_kit_hal_interface;
+/* The HAL of the selected interface. g_kit_hal_selected points to it, and
+   g_kit_hal_interface keeps a copy of it for the applications which call the HAL
+   through g_kit_hal_interface.<function>(); they can move to g_kit_hal_selected,
+   or to the hal of their device_info_t, as the copy may be removed later. */
+extern struct kit_hal_interface g_kit_hal_interface;         //!< Copy of the HAL of the selected interface
+extern const struct kit_hal_interface *g_kit_hal_selected;   //!< HAL of the selected interface
 
 //!< Following variable instances to be created by the application.
 //!< This module links these apis to Kitprotocol parser for reference
@@ -135,6 +176,10 @@ extern enum kit_protocol_status hal_i2c_idle(uint32_t);
 extern enum kit_protocol_status hal_i2c_send(uint32_t, uint8_t*, uint16_t*);
 extern enum kit_protocol_status hal_i2c_receive(uint32_t, uint8_t*, uint16_t*);
 extern enum kit_protocol_status hal_i2c_talk(uint32_t, uint8_t*, uint16_t*);
+#ifdef KIT_HAL_TALK_ASYNC
+extern enum kit_protocol_status hal_i2c_talk_start(uint32_t, uint8_t*, uint16_t*);
+extern enum kit_protocol_status hal_i2c_talk_complete(uint32_t, uint8_t*, uint16_t*);
+#endif
 #endif
 
 #ifdef KIT_HAL_SWI
@@ -147,6 +192,10 @@ extern enum kit_protocol_status hal_swi_idle(uint32_t);
 extern enum kit_protocol_status hal_swi_send(uint32_t, uint8_t*, uint16_t*);
 extern enum kit_protocol_status hal_swi_receive(uint32_t, uint8_t*, uint16_t*);
 extern enum kit_protocol_status hal_swi_talk(uint32_t, uint8_t*, uint16_t*);
+#ifdef KIT_HAL_TALK_ASYNC
+extern enum kit_protocol_status hal_swi_talk_start(uint32_t, uint8_t*, uint16_t*);
+extern enum kit_protocol_status hal_swi_talk_complete(uint32_t, uint8_t*, uint16_t*);
+#endif
 #endif
 
 #ifdef KIT_HAL_SPI
@@ -159,6 +208,10 @@ extern enum kit_protocol_status hal_spi_idle(uint32_t);
 extern enum kit_protocol_status hal_spi_send(uint32_t, uint8_t*, uint16_t*);
 extern enum kit_protocol_status hal_spi_receive(uint32_t, uint8_t*, uint16_t*);
 extern enum kit_protocol_status hal_spi_talk(uint32_t, uint8_t*, uint16_t*);
+#ifdef KIT_HAL_TALK_ASYNC
+extern enum kit_protocol_status hal_spi_talk_start(uint32_t, uint8_t*, uint16_t*);
+extern enum kit_protocol_status hal_spi_talk_complete(uint32_t, uint8_t*, uint16_t*);
+#endif
 #endif
 
 #ifdef KIT_HAL_SWI2
@@ -171,10 +224,28 @@ extern enum kit_protocol_status hal_gpio_idle(uint32_t);
 extern enum kit_protocol_status hal_gpio_send(uint32_t, uint8_t*, uint16_t*);
 extern enum kit_protocol_status hal_gpio_receive(uint32_t, uint8_t*, uint16_t*);
 extern enum kit_protocol_status hal_gpio_talk(uint32_t, uint8_t*, uint16_t*);
+#ifdef KIT_HAL_TALK_ASYNC
+extern enum kit_protocol_status hal_gpio_talk_start(uint32_t, uint8_t*, uint16_t*);
+extern enum kit_protocol_status hal_gpio_talk_complete(uint32_t, uint8_t*, uint16_t*);
+#endif
 #endif
 
 extern void kit_delay_ms(uint32_t delay_in_ms);
 
+#ifdef KIT_HAL_DELAY_US
+extern void kit_delay_us(uint32_t delay_in_us);
+// The delay kit_delay_us() waits at least, in microseconds
+#define KIT_DELAY_US_APPLIED(delay_in_us)    (delay_in_us)
+#else
+// Without a microsecond delay the delays are rounded up to milliseconds
+#define kit_delay_us(delay_in_us)    kit_delay_ms(((delay_in_us) + 999) / 1000)
+#define KIT_DELAY_US_APPLIED(delay_in_us)    ((((delay_in_us) + 999) / 1000) * 1000)
+#endif // KIT_HAL_DELAY_US
+
+#ifdef KIT_HAL_TIMER
+extern uint32_t kit_get_time_ms(void);
+#endif // KIT_HAL_TIMER
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -0,0 +1,173 @@
+/**
+ * \file
+ *
+ * \brief  KIT protocol binary traffic capture
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#include <stddef.h>
+#include "kit_protocol_capture.h"
+
+static kit_capture_writer_t g_kit_capture_writer;
+static kit_trace_clock_t g_kit_capture_clock;
+
+/** \brief Stores a little endian value.
+ *
+ *  \param[in]    value                  The value
+ *                size                   The size of the value, in bytes
+ *
+ *  \param[out]   buffer                 The little endian bytes
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void kit_capture_put(uint8_t *buffer, uint32_t value, uint8_t size)
+{
+    for (uint8_t index = 0; index < size; index++)
+    {
+        buffer[index] = (uint8_t)(value >> (8 * index));
+    }
+}
+
+/** \brief Loads a little endian value.
+ *
+ *  \param[in]    buffer                 The little endian bytes
+ *                size                   The size of the value, in bytes
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The value
+ */
+static uint32_t kit_capture_get(const uint8_t *buffer, uint8_t size)
+{
+    uint32_t value = 0;
+
+    for (uint8_t index = size; index > 0; index--)
+    {
+        value = (value << 8) | buffer[index - 1];
+    }
+
+    return value;
+}
+
+bool kit_capture_start(kit_capture_writer_t writer, kit_trace_clock_t clock, uint32_t clock_rate)
+{
+    uint8_t header[KIT_CAPTURE_HEADER_SIZE] = {0};
+
+    if ((writer == NULL) || (clock == NULL) || (clock_rate == 0))
+    {
+        return false;
+    }
+
+    kit_capture_put(&header[0], KIT_CAPTURE_MAGIC, 4);
+    kit_capture_put(&header[4], KIT_CAPTURE_VERSION, 2);
+    kit_capture_put(&header[6], KIT_CAPTURE_HEADER_SIZE, 2);
+    kit_capture_put(&header[8], clock_rate, 4);
+    writer(header, sizeof(header));
+
+    g_kit_capture_clock = clock;
+    g_kit_capture_writer = writer;
+
+    return true;
+}
+
+void kit_capture_stop(void)
+{
+    g_kit_capture_writer = NULL;
+}
+
+void kit_capture_record(enum kit_trace_direction direction, uint32_t device_id, uint8_t bus_type, uint8_t flags,
+                        const uint8_t *data, uint16_t length)
+{
+    uint8_t record[KIT_CAPTURE_RECORD_SIZE] = {0};
+    const kit_capture_writer_t writer = g_kit_capture_writer;
+
+    if ((writer == NULL) || (data == NULL))
+    {
+        return;
+    }
+
+    kit_capture_put(&record[0], g_kit_capture_clock(), 4);
+    kit_capture_put(&record[4], device_id, 4);
+    kit_capture_put(&record[8], length, 2);
+    record[10] = (uint8_t)direction;
+    record[11] = bus_type;
+    record[12] = flags;
+
+    writer(record, sizeof(record));
+    writer(data, length);
+}
+
+uint16_t kit_capture_read_header(const uint8_t *buffer, uint32_t length, struct kit_capture_header *header)
+{
+    uint16_t header_size;
+
+    if ((buffer == NULL) || (header == NULL) || (length < KIT_CAPTURE_HEADER_SIZE) ||
+        (kit_capture_get(&buffer[0], 4) != KIT_CAPTURE_MAGIC))
+    {
+        return 0;
+    }
+
+    header->version = (uint16_t)kit_capture_get(&buffer[4], 2);
+    header_size = (uint16_t)kit_capture_get(&buffer[6], 2);
+    header->clock_rate = kit_capture_get(&buffer[8], 4);
+
+    // Newer versions may only append fields to the header
+    if ((header->version < KIT_CAPTURE_VERSION) || (header_size < KIT_CAPTURE_HEADER_SIZE) || (header_size > length))
+    {
+        return 0;
+    }
+
+    return header_size;
+}
+
+uint32_t kit_capture_read_record(const uint8_t *buffer, uint32_t length, struct kit_capture_record *record)
+{
+    if ((buffer == NULL) || (record == NULL) || (length < KIT_CAPTURE_RECORD_SIZE))
+    {
+        return 0;
+    }
+
+    record->timestamp = kit_capture_get(&buffer[0], 4);
+    record->device_id = kit_capture_get(&buffer[4], 4);
+    record->length = (uint16_t)kit_capture_get(&buffer[8], 2);
+    record->direction = buffer[10];
+    record->bus_type = buffer[11];
+    record->flags = buffer[12];
+    record->data = &buffer[KIT_CAPTURE_RECORD_SIZE];
+
+    if ((length - KIT_CAPTURE_RECORD_SIZE) < record->length)
+    {
+        return 0;
+    }
+
+    return (KIT_CAPTURE_RECORD_SIZE + (uint32_t)record->length);
+}
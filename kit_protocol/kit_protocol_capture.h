@@ -0,0 +1,161 @@
+/**
+ * \file
+ *
+ * \brief  KIT protocol binary traffic capture
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#ifndef KIT_PROTOCOL_CAPTURE_H
+#define KIT_PROTOCOL_CAPTURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "kit_protocol_trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/**
+ * \brief The capture format. All the fields are little endian.
+ * \note
+ *    Capture: <header><record>...
+ *    Header:  <magic:4 "KCAP"><version:2><header size:2><clock rate:4><reserved:4>
+ *    Record:  <timestamp:4><device handle:4><length:2><direction:1><bus type:1><flags:1><reserved:3><raw bytes>
+ */
+#define KIT_CAPTURE_MAGIC             (0x5041434B)  //! "KCAP"
+#define KIT_CAPTURE_VERSION           (1)           //! The capture format version
+#define KIT_CAPTURE_HEADER_SIZE       (16)          //! The size of the capture header
+#define KIT_CAPTURE_RECORD_SIZE       (16)          //! The size of the record header, the raw bytes follow it
+
+#define KIT_CAPTURE_FLAG_BINARY       (0x01)        //! The raw bytes are a binary frame (board:binary)
+
+/**
+ * \brief The capture header.
+ */
+struct kit_capture_header
+{
+    uint16_t version;           //!< The capture format version
+    uint32_t clock_rate;        //!< The number of timestamp ticks per second
+};
+
+/**
+ * \brief A capture record.
+ */
+struct kit_capture_record
+{
+    uint32_t timestamp;         //!< The monotonic clock time
+    uint32_t device_id;         //!< The selected device handle
+    uint16_t length;            //!< The number of raw bytes
+    uint8_t direction;          //!< The traffic direction (enum kit_trace_direction)
+    uint8_t bus_type;           //!< The bus of the selected device (interface_id_t)
+    uint8_t flags;              //!< The KIT_CAPTURE_FLAG_ record flags
+    const uint8_t *data;        //!< The raw bytes
+};
+
+/**
+ * \brief The capture writer, stores the capture bytes (Ex. a file or a debug port).
+ */
+typedef void (*kit_capture_writer_t)(const uint8_t *data, uint16_t length);
+
+/** \brief Starts the capture, writes the capture header.
+ *
+ *  \param[in]    writer                 The capture writer
+ *                clock                  The monotonic clock of the timestamps
+ *                clock_rate             The number of clock ticks per second
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return true on success, otherwise false
+ */
+bool kit_capture_start(kit_capture_writer_t writer, kit_trace_clock_t clock, uint32_t clock_rate);
+
+/** \brief Stops the capture.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_capture_stop(void);
+
+/** \brief Writes a capture record with all the raw bytes of the traffic. Nothing
+ *         is written when the capture is not started.
+ *
+ *  \param[in]    direction              The traffic direction
+ *                device_id              The selected device handle
+ *                bus_type               The bus of the selected device
+ *                flags                  The KIT_CAPTURE_FLAG_ record flags
+ *                data                   The raw bytes
+ *                length                 The number of raw bytes
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_capture_record(enum kit_trace_direction direction, uint32_t device_id, uint8_t bus_type, uint8_t flags,
+                        const uint8_t *data, uint16_t length);
+
+/** \brief Reads the capture header.
+ *
+ *  \param[in]    buffer                 The capture bytes
+ *                length                 The number of capture bytes
+ *
+ *  \param[out]   header                 The capture header
+ *
+ *  \param[inout] None
+ *
+ *  \return The size of the capture header, 0 when the bytes are not a supported capture
+ */
+uint16_t kit_capture_read_header(const uint8_t *buffer, uint32_t length, struct kit_capture_header *header);
+
+/** \brief Reads a capture record, its raw bytes reference the capture bytes.
+ *
+ *  \param[in]    buffer                 The capture bytes, from the start of the record
+ *                length                 The number of capture bytes
+ *
+ *  \param[out]   record                 The capture record
+ *
+ *  \param[inout] None
+ *
+ *  \return The size of the record, 0 when the record is truncated
+ */
+uint32_t kit_capture_read_record(const uint8_t *buffer, uint32_t length, struct kit_capture_record *record);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // KIT_PROTOCOL_CAPTURE_H
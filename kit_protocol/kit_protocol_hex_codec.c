@@ -0,0 +1,447 @@
+/**
+ * \file
+ *
+ * \brief  KIT protocol ASCII hex codec
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#include <string.h>
+#include "kit_protocol_hex_codec.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define KIT_HEX_CODEC_SSE2
+#if defined(__GNUC__)
+#include <immintrin.h>
+#define KIT_HEX_CODEC_AVX2
+#endif // __GNUC__
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define KIT_HEX_CODEC_NEON
+#endif
+
+const uint8_t g_kit_hex_decode_table[256] =
+{
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0x00
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0x10
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0x20
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0x30
+    0x10, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0x40
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0x50
+    0x10, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0x60
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0x70
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0x80
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0x90
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0xA0
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0xB0
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0xC0
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0xD0
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0xE0
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,  // 0xF0
+};
+
+const char g_kit_hex_encode_table[512] =
+    "000102030405060708090A0B0C0D0E0F"
+    "101112131415161718191A1B1C1D1E1F"
+    "202122232425262728292A2B2C2D2E2F"
+    "303132333435363738393A3B3C3D3E3F"
+    "404142434445464748494A4B4C4D4E4F"
+    "505152535455565758595A5B5C5D5E5F"
+    "606162636465666768696A6B6C6D6E6F"
+    "707172737475767778797A7B7C7D7E7F"
+    "808182838485868788898A8B8C8D8E8F"
+    "909192939495969798999A9B9C9D9E9F"
+    "A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+    "B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+    "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+    "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+    "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+    "F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+/**
+ * \brief The bulk conversion kernels.
+ */
+struct kit_hex_kernels
+{
+    const char *name;
+    void (*encode)(const uint8_t *binary, uint16_t length, uint8_t *hex);
+    uint32_t (*decode)(const uint8_t *hex, uint16_t length, uint8_t *binary);
+};
+
+/** \brief Returns the index of the lowest bit set in a non-zero mask (only used on errors). */
+static uint32_t kit_hex_first_bit(uint64_t mask)
+{
+    uint32_t bit = 0;
+
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        bit++;
+    }
+
+    return bit;
+}
+
+/** \brief Encodes the bytes of a binary buffer from the end backwards. */
+static void kit_hex_encode_scalar(const uint8_t *binary, uint16_t length, uint8_t *hex)
+{
+    while (length > 0)
+    {
+        length--;
+        memcpy(&hex[length * 2], &g_kit_hex_encode_table[binary[length] * 2], 2);
+    }
+}
+
+/** \brief Decodes the character pairs of an ASCII hex buffer. */
+static uint32_t kit_hex_decode_scalar(const uint8_t *hex, uint16_t length, uint8_t *binary)
+{
+    uint32_t invalid_offset = KIT_HEX_VALID;
+    uint32_t offset;
+    uint8_t upper;
+    uint8_t lower;
+
+    for (uint16_t index = 0; index < length; index++)
+    {
+        upper = g_kit_hex_decode_table[hex[index * 2]];
+        lower = g_kit_hex_decode_table[hex[(index * 2) + 1]];
+
+        // Keep the offset of the first character which is not ASCII hex (selects, no branches)
+        offset = (uint32_t)(index * 2) + ((upper & KIT_HEX_INVALID) ? 0 : 1);
+        invalid_offset = (((upper | lower) & KIT_HEX_INVALID) && (invalid_offset == KIT_HEX_VALID)) ? offset : invalid_offset;
+
+        // The characters which are not ASCII hex decode as 0
+        upper &= (uint8_t)((upper & KIT_HEX_INVALID) - 1);
+        lower &= (uint8_t)((lower & KIT_HEX_INVALID) - 1);
+
+        binary[index] = (uint8_t)((upper << 4) | lower);
+    }
+
+    return invalid_offset;
+}
+
+static const struct kit_hex_kernels g_kit_hex_scalar_kernels =
+{
+    "scalar", kit_hex_encode_scalar, kit_hex_decode_scalar
+};
+
+/** \brief Decodes the bytes left after the vector blocks and merges the invalid character offsets. */
+static uint32_t kit_hex_decode_tail(const uint8_t *hex, uint16_t length, uint8_t *binary, uint16_t index, uint32_t invalid_offset,
+                                    uint32_t (*decode)(const uint8_t *hex, uint16_t length, uint8_t *binary))
+{
+    const uint32_t tail_offset = decode(&hex[index * 2], length - index, &binary[index]);
+
+    if ((invalid_offset == KIT_HEX_VALID) && (tail_offset != KIT_HEX_VALID))
+    {
+        invalid_offset = (uint32_t)(index * 2) + tail_offset;
+    }
+
+    return invalid_offset;
+}
+
+#ifdef KIT_HEX_CODEC_SSE2
+/** \brief Converts 16 nibbles to uppercase ASCII hex characters. */
+static __m128i kit_hex_sse2_nibble_to_hex(__m128i nibble)
+{
+    const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(nibble, _mm_set1_epi8(9)), _mm_set1_epi8('A' - '0' - 10));
+
+    return _mm_add_epi8(_mm_add_epi8(nibble, _mm_set1_epi8('0')), letter);
+}
+
+/** \brief Converts 16 ASCII hex characters to nibbles, the other characters to 0
+ *         and flagged in the returned valid character bit mask. */
+static __m128i kit_hex_sse2_hex_to_nibble(__m128i hex, uint32_t *valid)
+{
+    const __m128i lowercase = _mm_or_si128(hex, _mm_set1_epi8(0x20));
+    const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(hex, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(hex, _mm_set1_epi8('9' + 1)));
+    const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lowercase, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lowercase, _mm_set1_epi8('f' + 1)));
+
+    *valid = (uint32_t)_mm_movemask_epi8(_mm_or_si128(digit, letter));
+
+    // '0'-'9' keep their low nibble, 'A'-'F' and 'a'-'f' low nibbles 1-6 become 10-15
+    return _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(hex, _mm_set1_epi8('0'))),
+                        _mm_and_si128(letter, _mm_sub_epi8(lowercase, _mm_set1_epi8('a' - 10))));
+}
+
+/** \brief Combines the 8 nibble pairs of each 16-bit lane into a byte in the low half. */
+static __m128i kit_hex_sse2_pair_nibbles(__m128i nibble)
+{
+    return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibble, _mm_set1_epi16(0x00FF)), 4), _mm_srli_epi16(nibble, 8));
+}
+
+static void kit_hex_encode_sse2(const uint8_t *binary, uint16_t length, uint8_t *hex)
+{
+    __m128i value;
+    __m128i upper;
+    __m128i lower;
+
+    // Encode the blocks from the end, each block is read before its characters are stored
+    while (length >= 16)
+    {
+        length -= 16;
+        value = _mm_loadu_si128((const __m128i*)&binary[length]);
+        upper = kit_hex_sse2_nibble_to_hex(_mm_and_si128(_mm_srli_epi16(value, 4), _mm_set1_epi8(0x0F)));
+        lower = kit_hex_sse2_nibble_to_hex(_mm_and_si128(value, _mm_set1_epi8(0x0F)));
+        _mm_storeu_si128((__m128i*)&hex[(length * 2) + 16], _mm_unpackhi_epi8(upper, lower));
+        _mm_storeu_si128((__m128i*)&hex[length * 2], _mm_unpacklo_epi8(upper, lower));
+    }
+
+    kit_hex_encode_scalar(binary, length, hex);
+}
+
+static uint32_t kit_hex_decode_sse2(const uint8_t *hex, uint16_t length, uint8_t *binary)
+{
+    uint32_t invalid_offset = KIT_HEX_VALID;
+    uint32_t first_valid;
+    uint32_t second_valid;
+    uint32_t invalid;
+    uint16_t index = 0;
+    __m128i first;
+    __m128i second;
+
+    for (; (length - index) >= 16; index += 16)
+    {
+        first = kit_hex_sse2_hex_to_nibble(_mm_loadu_si128((const __m128i*)&hex[index * 2]), &first_valid);
+        second = kit_hex_sse2_hex_to_nibble(_mm_loadu_si128((const __m128i*)&hex[(index * 2) + 16]), &second_valid);
+        _mm_storeu_si128((__m128i*)&binary[index], _mm_packus_epi16(kit_hex_sse2_pair_nibbles(first), kit_hex_sse2_pair_nibbles(second)));
+
+        invalid = ~(first_valid | (second_valid << 16));
+        if ((invalid != 0) && (invalid_offset == KIT_HEX_VALID))
+        {
+            invalid_offset = (uint32_t)(index * 2) + kit_hex_first_bit(invalid);
+        }
+    }
+
+    return kit_hex_decode_tail(hex, length, binary, index, invalid_offset, kit_hex_decode_scalar);
+}
+
+static const struct kit_hex_kernels g_kit_hex_sse2_kernels =
+{
+    "sse2", kit_hex_encode_sse2, kit_hex_decode_sse2
+};
+#endif // KIT_HEX_CODEC_SSE2
+
+#ifdef KIT_HEX_CODEC_AVX2
+#define KIT_HEX_AVX2 __attribute__((target("avx2")))
+
+KIT_HEX_AVX2 static __m256i kit_hex_avx2_nibble_to_hex(__m256i nibble)
+{
+    const __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(nibble, _mm256_set1_epi8(9)), _mm256_set1_epi8('A' - '0' - 10));
+
+    return _mm256_add_epi8(_mm256_add_epi8(nibble, _mm256_set1_epi8('0')), letter);
+}
+
+KIT_HEX_AVX2 static __m256i kit_hex_avx2_hex_to_nibble(__m256i hex, uint64_t *valid)
+{
+    const __m256i lowercase = _mm256_or_si256(hex, _mm256_set1_epi8(0x20));
+    const __m256i digit = _mm256_andnot_si256(_mm256_cmpgt_epi8(hex, _mm256_set1_epi8('9')), _mm256_cmpgt_epi8(hex, _mm256_set1_epi8('0' - 1)));
+    const __m256i letter = _mm256_andnot_si256(_mm256_cmpgt_epi8(lowercase, _mm256_set1_epi8('f')), _mm256_cmpgt_epi8(lowercase, _mm256_set1_epi8('a' - 1)));
+
+    *valid = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(digit, letter));
+
+    return _mm256_or_si256(_mm256_and_si256(digit, _mm256_sub_epi8(hex, _mm256_set1_epi8('0'))),
+                           _mm256_and_si256(letter, _mm256_sub_epi8(lowercase, _mm256_set1_epi8('a' - 10))));
+}
+
+KIT_HEX_AVX2 static __m256i kit_hex_avx2_pair_nibbles(__m256i nibble)
+{
+    return _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(nibble, _mm256_set1_epi16(0x00FF)), 4), _mm256_srli_epi16(nibble, 8));
+}
+
+KIT_HEX_AVX2 static void kit_hex_encode_avx2(const uint8_t *binary, uint16_t length, uint8_t *hex)
+{
+    __m256i value;
+    __m256i upper;
+    __m256i lower;
+    __m256i first;
+    __m256i second;
+
+    // Encode the blocks from the end, each block is read before its characters are stored
+    while (length >= 32)
+    {
+        length -= 32;
+        value = _mm256_loadu_si256((const __m256i*)&binary[length]);
+        upper = kit_hex_avx2_nibble_to_hex(_mm256_and_si256(_mm256_srli_epi16(value, 4), _mm256_set1_epi8(0x0F)));
+        lower = kit_hex_avx2_nibble_to_hex(_mm256_and_si256(value, _mm256_set1_epi8(0x0F)));
+
+        // The unpack instructions interleave each 128-bit lane separately
+        first = _mm256_unpacklo_epi8(upper, lower);
+        second = _mm256_unpackhi_epi8(upper, lower);
+        _mm256_storeu_si256((__m256i*)&hex[(length * 2) + 32], _mm256_permute2x128_si256(first, second, 0x31));
+        _mm256_storeu_si256((__m256i*)&hex[length * 2], _mm256_permute2x128_si256(first, second, 0x20));
+    }
+
+    kit_hex_encode_sse2(binary, length, hex);
+}
+
+KIT_HEX_AVX2 static uint32_t kit_hex_decode_avx2(const uint8_t *hex, uint16_t length, uint8_t *binary)
+{
+    uint32_t invalid_offset = KIT_HEX_VALID;
+    uint64_t first_valid;
+    uint64_t second_valid;
+    uint64_t invalid;
+    uint16_t index = 0;
+    __m256i first;
+    __m256i second;
+
+    for (; (length - index) >= 32; index += 32)
+    {
+        first = kit_hex_avx2_pair_nibbles(kit_hex_avx2_hex_to_nibble(_mm256_loadu_si256((const __m256i*)&hex[index * 2]), &first_valid));
+        second = kit_hex_avx2_pair_nibbles(kit_hex_avx2_hex_to_nibble(_mm256_loadu_si256((const __m256i*)&hex[(index * 2) + 32]), &second_valid));
+
+        // The pack instruction works on each 128-bit lane separately
+        _mm256_storeu_si256((__m256i*)&binary[index], _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), 0xD8));
+
+        invalid = ~(first_valid | (second_valid << 32));
+        if ((invalid != 0) && (invalid_offset == KIT_HEX_VALID))
+        {
+            invalid_offset = (uint32_t)(index * 2) + kit_hex_first_bit(invalid);
+        }
+    }
+
+    return kit_hex_decode_tail(hex, length, binary, index, invalid_offset, kit_hex_decode_sse2);
+}
+
+static const struct kit_hex_kernels g_kit_hex_avx2_kernels =
+{
+    "avx2", kit_hex_encode_avx2, kit_hex_decode_avx2
+};
+#endif // KIT_HEX_CODEC_AVX2
+
+#ifdef KIT_HEX_CODEC_NEON
+static uint8x16_t kit_hex_neon_nibble_to_hex(uint8x16_t nibble)
+{
+    const uint8x16_t letter = vandq_u8(vcgtq_u8(nibble, vdupq_n_u8(9)), vdupq_n_u8('A' - '0' - 10));
+
+    return vaddq_u8(vaddq_u8(nibble, vdupq_n_u8('0')), letter);
+}
+
+static uint8x16_t kit_hex_neon_hex_to_nibble(uint8x16_t hex, uint8x16_t *valid)
+{
+    const uint8x16_t digit = vsubq_u8(hex, vdupq_n_u8('0'));
+    const uint8x16_t letter = vsubq_u8(vorrq_u8(hex, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t is_digit = vcltq_u8(digit, vdupq_n_u8(10));
+    const uint8x16_t is_letter = vcltq_u8(letter, vdupq_n_u8(6));
+
+    *valid = vorrq_u8(is_digit, is_letter);
+
+    // The unsigned offsets from '0' and 'a' are below 10 and 6 for valid characters only
+    return vorrq_u8(vandq_u8(is_digit, digit), vandq_u8(is_letter, vaddq_u8(letter, vdupq_n_u8(10))));
+}
+
+static void kit_hex_encode_neon(const uint8_t *binary, uint16_t length, uint8_t *hex)
+{
+    uint8x16_t value;
+    uint8x16x2_t characters;
+
+    // Encode the blocks from the end, each block is read before its characters are stored
+    while (length >= 16)
+    {
+        length -= 16;
+        value = vld1q_u8(&binary[length]);
+        characters.val[0] = kit_hex_neon_nibble_to_hex(vshrq_n_u8(value, 4));
+        characters.val[1] = kit_hex_neon_nibble_to_hex(vandq_u8(value, vdupq_n_u8(0x0F)));
+        vst2q_u8(&hex[length * 2], characters);
+    }
+
+    kit_hex_encode_scalar(binary, length, hex);
+}
+
+static uint32_t kit_hex_decode_neon(const uint8_t *hex, uint16_t length, uint8_t *binary)
+{
+    uint32_t invalid_offset = KIT_HEX_VALID;
+    uint16_t index = 0;
+    uint8x16x2_t characters;
+    uint8x16x2_t valid;
+    uint64x2_t invalid;
+    uint8_t flags[32];
+
+    for (; (length - index) >= 16; index += 16)
+    {
+        // Load the upper nibble characters into val[0] and the lower ones into val[1]
+        characters = vld2q_u8(&hex[index * 2]);
+        vst1q_u8(&binary[index], vorrq_u8(vshlq_n_u8(kit_hex_neon_hex_to_nibble(characters.val[0], &valid.val[0]), 4),
+                                          kit_hex_neon_hex_to_nibble(characters.val[1], &valid.val[1])));
+
+        invalid = vreinterpretq_u64_u8(vmvnq_u8(vandq_u8(valid.val[0], valid.val[1])));
+        if (((vgetq_lane_u64(invalid, 0) | vgetq_lane_u64(invalid, 1)) != 0) && (invalid_offset == KIT_HEX_VALID))
+        {
+            // Interleave the flags back into the character order to find the first one
+            vst2q_u8(flags, valid);
+            invalid_offset = (uint32_t)(index * 2);
+            while (flags[invalid_offset - (index * 2)] != 0)
+            {
+                invalid_offset++;
+            }
+        }
+    }
+
+    return kit_hex_decode_tail(hex, length, binary, index, invalid_offset, kit_hex_decode_scalar);
+}
+
+static const struct kit_hex_kernels g_kit_hex_neon_kernels =
+{
+    "neon", kit_hex_encode_neon, kit_hex_decode_neon
+};
+#endif // KIT_HEX_CODEC_NEON
+
+// The selected kernels, the scalar ones until kit_hex_codec_init is called
+static const struct kit_hex_kernels *g_kit_hex_kernels = &g_kit_hex_scalar_kernels;
+
+void kit_hex_codec_init(void)
+{
+    g_kit_hex_kernels = &g_kit_hex_scalar_kernels;
+
+#if defined(KIT_HEX_CODEC_SSE2)
+    // SSE2 is part of the x86-64 baseline
+    g_kit_hex_kernels = &g_kit_hex_sse2_kernels;
+#if defined(KIT_HEX_CODEC_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        g_kit_hex_kernels = &g_kit_hex_avx2_kernels;
+    }
+#endif // KIT_HEX_CODEC_AVX2
+#elif defined(KIT_HEX_CODEC_NEON)
+    g_kit_hex_kernels = &g_kit_hex_neon_kernels;
+#endif
+}
+
+const char *kit_hex_codec_get_kernel_name(void)
+{
+    return g_kit_hex_kernels->name;
+}
+
+void kit_hex_codec_encode(const uint8_t *binary, uint16_t length, uint8_t *hex)
+{
+    g_kit_hex_kernels->encode(binary, length, hex);
+}
+
+uint32_t kit_hex_codec_decode(const uint8_t *hex, uint16_t length, uint8_t *binary)
+{
+    return g_kit_hex_kernels->decode(hex, length, binary);
+}
@@ -0,0 +1,119 @@
+/**
+ * \file
+ *
+ * \brief  KIT protocol ASCII hex codec
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#ifndef KIT_PROTOCOL_HEX_CODEC_H
+#define KIT_PROTOCOL_HEX_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#define KIT_HEX_INVALID  (0x10)        //! Decode table flag of the characters which are not ASCII hex
+#define KIT_HEX_VALID    (0xFFFFFFFF)  //! Decode result when all the characters are ASCII hex
+
+/**
+ * \brief The ASCII hex decode table. Each entry holds the nibble value of the
+ *        character, or KIT_HEX_INVALID for the other characters.
+ */
+extern const uint8_t g_kit_hex_decode_table[256];
+
+/**
+ * \brief The ASCII hex encode table. Entries 2n and 2n + 1 hold the uppercase
+ *        ASCII hex characters of the byte n.
+ */
+extern const char g_kit_hex_encode_table[512];
+
+/** \brief Selects the fastest hex codec kernels supported by the processor.
+ *         The scalar kernels are used until it is called.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_hex_codec_init(void);
+
+/** \brief Returns the name of the selected hex codec kernels (Ex. scalar, sse2, avx2, neon).
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The null-terminated kernel name
+ */
+const char *kit_hex_codec_get_kernel_name(void);
+
+/** \brief Encodes a binary buffer to uppercase ASCII hex characters.
+ *
+ *  \note  The ASCII hex buffer may be the binary buffer itself (in place
+ *         conversion); the bytes are encoded from the end backwards.
+ *
+ *  \param[in]    binary                 The binary buffer
+ *                length                 The length of the binary buffer
+ *
+ *  \param[out]   hex                    The ASCII hex buffer (2 * length characters, not null-terminated)
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_hex_codec_encode(const uint8_t *binary, uint16_t length, uint8_t *hex);
+
+/** \brief Decodes ASCII hex character pairs to a binary buffer. The characters
+ *         which are not ASCII hex decode as 0 and are reported in the same pass.
+ *
+ *  \note  The binary buffer may alias the start of the ASCII hex buffer.
+ *
+ *  \param[in]    hex                    The ASCII hex buffer (2 * length characters)
+ *                length                 The length of the binary buffer
+ *
+ *  \param[out]   binary                 The binary buffer
+ *
+ *  \param[inout] None
+ *
+ *  \return The offset of the first character which is not ASCII hex, KIT_HEX_VALID when all are
+ */
+uint32_t kit_hex_codec_decode(const uint8_t *hex, uint16_t length, uint8_t *binary);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // KIT_PROTOCOL_HEX_CODEC_H
@@ -34,16 +34,334 @@
 #include <stdlib.h>
 #include "kit_protocol_interpreter.h"
 #include "kit_protocol_init.h"
+#include "kit_protocol_capture.h"
+#include "kit_protocol_profile.h"
+#include "kit_protocol_script.h"
+#include "kit_protocol_trace.h"
 #include "kit_hal_interface.h"
 #include "kit_host_interface.h"
 #include "kitprotocol_parser_info.h"
 
-static uint8_t command_separate = 0;
-static uint8_t command_talk = 0;
-
 // Global variable
 static struct kit_interpreter_interface g_kit_interpreter_interface;
 
+#ifdef KIT_PROTOCOL_PIPELINE
+// The responses of all the messages received in one host buffer
+static char g_kit_pipeline_response[KIT_MESSAGE_SIZE_MAX];
+#endif // KIT_PROTOCOL_PIPELINE
+
+#ifndef KIT_WAKE_POLL_MIN_US
+#define KIT_WAKE_POLL_MIN_US    (100)    //! The first wake response poll interval
+#endif // KIT_WAKE_POLL_MIN_US
+
+#ifndef KIT_WAKE_POLL_MAX_US
+#define KIT_WAKE_POLL_MAX_US    (2000)   //! The largest wake response poll interval
+#endif // KIT_WAKE_POLL_MAX_US
+
+#ifndef KIT_WAKE_TIMEOUT_US
+#define KIT_WAKE_TIMEOUT_US     (32000)  //! The longest wait for the wake response
+#endif // KIT_WAKE_TIMEOUT_US
+
+#ifndef KIT_EXECUTION_POLL_US
+#define KIT_EXECUTION_POLL_US   (250)    //! The command response poll interval, once the typical execution time is over
+#endif // KIT_EXECUTION_POLL_US
+
+#if defined(KIT_PROTOCOL_TIMING) && !defined(KIT_HAL_TALK_SCHEDULE)
+#error KIT_PROTOCOL_TIMING learns the execution times of the KIT_HAL_TALK_SCHEDULE talk
+#endif
+
+#ifdef KIT_PROTOCOL_TIMING
+#ifndef KIT_EXECUTION_ESTIMATES
+#define KIT_EXECUTION_ESTIMATES (32)     //! The number of learned command execution times
+#endif // KIT_EXECUTION_ESTIMATES
+
+#define KIT_EXECUTION_ESTIMATE_SIZE  (14)  //! The size of a learned execution time in the board:timing response
+#define KIT_EXECUTION_RESET          (0x01)  //! The board:timing data byte which clears the learned execution times
+
+#if ((KIT_EXECUTION_ESTIMATES * KIT_EXECUTION_ESTIMATE_SIZE * 2) + 8) > KIT_MESSAGE_SIZE_MAX
+#error KIT_EXECUTION_ESTIMATES does not fit in the board:timing response
+#endif
+#endif // KIT_PROTOCOL_TIMING
+
+/**
+ * \brief The learned execution time of a device command.
+ */
+struct kit_execution_estimate
+{
+    uint8_t address;           //!< The device address
+    uint8_t bus_type;          //!< The device interface
+    uint8_t opcode;            //!< The command opcode
+    uint8_t mode;              //!< The command mode (param1)
+    uint16_t count;            //!< The number of measurements, 0 for an unused entry
+    uint32_t average_us;       //!< The moving average of the execution time, in microseconds
+    uint32_t max_us;           //!< The longest execution time, in microseconds
+};
+
+#ifdef KIT_PROTOCOL_TIMING
+static struct kit_execution_estimate g_kit_execution_estimates[KIT_EXECUTION_ESTIMATES];
+static uint8_t g_kit_execution_estimate_next;   // The entry replaced once they are all used
+#endif // KIT_PROTOCOL_TIMING
+
+#if defined(KIT_PROTOCOL_POWER) && !defined(KIT_HAL_TIMER)
+#error KIT_PROTOCOL_POWER tracks the device watchdogs with the kit_get_time_ms() of KIT_HAL_TIMER
+#endif
+
+#ifndef KIT_WATCHDOG_GUARD_MS
+#define KIT_WATCHDOG_GUARD_MS   (300)    //! The devices are no longer known to be awake this long before their watchdog expires
+#endif // KIT_WATCHDOG_GUARD_MS
+
+/**
+ * \brief The power state of a device, as known from the tokens sent to it.
+ */
+enum kit_device_power_state
+{
+    KIT_POWER_UNKNOWN = 0,     //!< Not known, the next wake is sent to the device
+    KIT_POWER_AWAKE,           //!< Awake until its watchdog deadline
+    KIT_POWER_IDLE,            //!< Idle, a wake is needed
+    KIT_POWER_ASLEEP           //!< Asleep, a wake is needed
+};
+
+/**
+ * \brief The last token sent to a device.
+ */
+enum kit_device_token
+{
+    KIT_TOKEN_NONE = 0,
+    KIT_TOKEN_WAKE,
+    KIT_TOKEN_IDLE,
+    KIT_TOKEN_SLEEP,
+    KIT_TOKEN_COMMAND
+};
+
+#ifdef KIT_PROTOCOL_POWER
+/**
+ * \brief The power state tracker of a device.
+ */
+struct kit_device_power
+{
+    uint8_t state;                 //!< The power state (enum kit_device_power_state)
+    uint8_t last_token;            //!< The last token sent (enum kit_device_token)
+    uint32_t last_token_time;      //!< The time the last token was sent, in milliseconds
+    uint32_t watchdog_deadline;    //!< The time the device goes to sleep when awake, in milliseconds
+};
+
+// The power state of each discovered device, by device index
+static struct kit_device_power g_kit_device_power[MAX_DISCOVER_DEVICES];
+#endif // KIT_PROTOCOL_POWER
+
+/**
+ * \brief The token ending a device transaction.
+ */
+enum kit_transact_token
+{
+    KIT_TRANSACT_NONE = 0x00,   //!< The device stays awake
+    KIT_TRANSACT_IDLE = 0x01,   //!< The device goes idle
+    KIT_TRANSACT_SLEEP = 0x02   //!< The device goes to sleep
+};
+
+#define KIT_TRANSACT_HEADER_SIZE   (3)    //! The step statuses ahead of the talk response
+
+#ifdef KIT_PROTOCOL_TALK_ASYNC
+#ifndef KIT_ASYNC_TICKETS
+#define KIT_ASYNC_TICKETS        (4)      //! The number of device:talk_async commands in flight, up to 16
+#endif // KIT_ASYNC_TICKETS
+
+#ifndef KIT_ASYNC_DATA_SIZE
+#define KIT_ASYNC_DATA_SIZE      (256)    //! The command packet, then the response, kept by a device:talk_async ticket
+#endif // KIT_ASYNC_DATA_SIZE
+
+#ifndef KIT_ASYNC_EXPIRY_MS
+#define KIT_ASYNC_EXPIRY_MS      (10000)  //! How long a completed device:talk_async response waits for device:poll (with KIT_HAL_TIMER)
+#endif // KIT_ASYNC_EXPIRY_MS
+
+#if (KIT_ASYNC_TICKETS > 16)
+#error KIT_ASYNC_TICKETS does not fit in the ticket number
+#endif
+
+#define KIT_ASYNC_TICKET_INDEX   (0x0F)   //! The ticket number bits of the ticket index, the others count the tickets issued
+
+/**
+ * \brief The state of a device:talk_async command.
+ */
+enum kit_async_mode
+{
+    KIT_ASYNC_FREE = 0,        //!< The ticket is not in use
+    KIT_ASYNC_QUEUED,          //!< The command waits in its device queue
+    KIT_ASYNC_HAL,             //!< The command was started, the HAL completes it (talk_complete)
+    KIT_ASYNC_POLLED,          //!< The command was sent, its response is polled
+    KIT_ASYNC_DONE             //!< The command completed, the ticket holds its response until polled
+};
+
+/**
+ * \brief A device:talk_async command.
+ */
+struct kit_async_ticket
+{
+    uint8_t mode;                          //!< The command state (enum kit_async_mode)
+    uint8_t number;                        //!< The ticket number returned to the host
+    uint8_t next;                          //!< The next ticket of the device queue (index + 1), 0 for the last one
+    uint8_t device_index;                  //!< The device of the command, its device_info index
+    bool cancelled;                        //!< The host gave up the command, the ticket is freed once it completes
+    uint32_t device_id;                    //!< The device address
+    uint32_t start_time;                   //!< The time the command was sent, in milliseconds
+    uint32_t done_time;                    //!< The time the command completed, in milliseconds
+    uint32_t ready_time_ms;                //!< The time before the first response poll, in milliseconds
+    uint32_t max_time_ms;                  //!< The longest execution time, in milliseconds
+    enum kit_protocol_status status;       //!< The status of a completed command
+    uint16_t length;                       //!< The length of the command packet, then of the response
+    uint8_t data[KIT_ASYNC_DATA_SIZE];     //!< The command packet, then the response
+};
+
+/**
+ * \brief The device:talk_async commands of a device, run one at a time in order.
+ */
+struct kit_device_queue
+{
+    uint8_t head;              //!< The command running or next to run (ticket index + 1), 0 when empty
+    uint8_t tail;              //!< The last queued command (ticket index + 1)
+};
+
+static struct kit_async_ticket g_kit_async_tickets[KIT_ASYNC_TICKETS];
+// The response of a talk_async command completed at once, the HAL may use all of a message buffer
+static uint8_t g_kit_async_response[KIT_MESSAGE_SIZE_MAX];
+static struct kit_device_queue g_kit_device_queues[MAX_DISCOVER_DEVICES];
+static uint8_t g_kit_async_queued;   // The number of queued or running commands
+static uint8_t g_kit_async_issued;   // The number of tickets issued, keeps the ticket numbers changing
+#endif // KIT_PROTOCOL_TALK_ASYNC
+
+// The response of a device which just woke up
+static const uint8_t g_kit_wake_response[] = {0x04, 0x11, 0x33, 0x43};
+
+// The observed wake latency of each device type and bus, in microseconds (0 until observed)
+static uint16_t g_kit_wake_latency[DEVICE_TYPE_SHA106 + 1][DEVKIT_IF_LAST];
+
+/** \brief Get the information of a discovered device.
+ *
+ *  \param[in]    device_id              The device address
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the device information, NULL when the device was not discovered
+ */
+static device_info_t *kit_device_get_info(uint32_t device_id)
+{
+    device_info_t *select_handle = kit_interpreter_get_selected_device_ctx(kit_interpreter_get_default_ctx());
+
+    // The selected device is the usual target, otherwise fall back to the address index
+    if ((select_handle == NULL) || (select_handle->address != device_id))
+    {
+        select_handle = get_device_info_by_address(device_id, DEVKIT_IF_UNKNOWN);
+    }
+
+    return select_handle;
+}
+
+/** \brief Get the HAL of a device.
+ *
+ *  \param[in]    device                 The device information, NULL when not discovered
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the HAL of the device bus, the HAL of the selected interface when not discovered
+ */
+static const struct kit_hal_interface *kit_device_get_hal(const device_info_t *device)
+{
+    return ((device != NULL) && (device->hal != NULL)) ? device->hal : g_kit_hal_selected;
+}
+
+/** \brief Updates the power state tracker of a device once a token was sent.
+ *
+ *  \param[in]    device                 The device information
+ *                state                  The power state the token puts the device in
+ *                token                  The token sent (a command keeps the power state)
+ *                status                 The status of the token, the power state is not
+ *                                       known anymore when it failed
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void kit_device_track_power(const device_info_t *device, enum kit_device_power_state state, enum kit_device_token token,
+                                   enum kit_protocol_status status)
+{
+#ifdef KIT_PROTOCOL_POWER
+    const device_info_t *first_device = get_device_info(0);
+    struct kit_device_power *power;
+    uint32_t now;
+
+    if ((device == NULL) || (first_device == NULL) || ((uint32_t)(device - first_device) >= MAX_DISCOVER_DEVICES))
+    {
+        return;
+    }
+
+    power = &g_kit_device_power[device - first_device];
+    now = kit_get_time_ms();
+
+    if (token == KIT_TOKEN_COMMAND)
+    {
+        state = (enum kit_device_power_state)power->state;
+    }
+
+    if (status != KIT_STATUS_SUCCESS)
+    {
+        state = KIT_POWER_UNKNOWN;
+    }
+    else if ((token == KIT_TOKEN_WAKE) && (state == KIT_POWER_AWAKE))
+    {
+        // The watchdog starts when the device wakes up
+        power->watchdog_deadline = now + get_device_watchdog_time(device->device_type);
+    }
+
+    power->state = (uint8_t)state;
+    power->last_token = (uint8_t)token;
+    power->last_token_time = now;
+#else
+    (void)device;
+    (void)state;
+    (void)token;
+    (void)status;
+#endif // KIT_PROTOCOL_POWER
+}
+
+/** \brief Checks whether a device is known to be awake, far enough from its watchdog deadline.
+ *
+ *  \param[in]    device                 The device information
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return true when the device is awake, false when it is not or when it is not known
+ */
+static bool kit_device_is_awake(const device_info_t *device)
+{
+#ifdef KIT_PROTOCOL_POWER
+    const device_info_t *first_device = get_device_info(0);
+    const struct kit_device_power *power;
+
+    if ((device == NULL) || (first_device == NULL) || ((uint32_t)(device - first_device) >= MAX_DISCOVER_DEVICES) ||
+        (get_device_watchdog_time(device->device_type) == 0))
+    {
+        return false;
+    }
+
+    power = &g_kit_device_power[device - first_device];
+
+    return ((power->state == KIT_POWER_AWAKE) &&
+            ((int32_t)(power->watchdog_deadline - KIT_WATCHDOG_GUARD_MS - kit_get_time_ms()) > 0)) ? true : false;
+#else
+    (void)device;
+
+    return false;
+#endif // KIT_PROTOCOL_POWER
+}
+
 void kit_protocol_init(void)
 {
     // Initialize the Kit Protocol Interpreter interface
@@ -53,6 +371,15 @@ void kit_protocol_init(void)
     g_kit_interpreter_interface.board_get_devices = &kit_board_get_devices;
     g_kit_interpreter_interface.board_discover = &kit_board_discover;
     g_kit_interpreter_interface.board_application = &kit_board_application;
+#ifdef KIT_PROTOCOL_TIMING
+    g_kit_interpreter_interface.board_timing = &kit_board_timing;
+#endif
+#ifdef KIT_PROTOCOL_SCRIPT
+    g_kit_interpreter_interface.board_script = &kit_script_run;
+#endif
+#ifdef KIT_HAL_PROFILE
+    g_kit_interpreter_interface.board_profile = &kit_board_profile;
+#endif
     g_kit_interpreter_interface.device_idle = &kit_device_idle;
     g_kit_interpreter_interface.device_sleep = &kit_device_sleep;
     g_kit_interpreter_interface.device_wake = &kit_device_wake;
@@ -61,6 +388,12 @@ void kit_protocol_init(void)
     g_kit_interpreter_interface.device_talk = &kit_device_talk;
     g_kit_interpreter_interface.device_mem_write = &kit_device_mem_write;
     g_kit_interpreter_interface.device_mem_read = &kit_device_mem_read;
+    g_kit_interpreter_interface.device_transact = &kit_device_transact;
+#ifdef KIT_PROTOCOL_TALK_ASYNC
+    g_kit_interpreter_interface.device_talk_async = &kit_device_talk_async;
+    g_kit_interpreter_interface.device_poll = &kit_device_poll;
+    g_kit_interpreter_interface.device_cancel = &kit_device_cancel;
+#endif
 
     kit_interpreter_init(&g_kit_interpreter_interface);
 }
@@ -243,6 +576,15 @@ enum kit_protocol_status kit_board_get_devices(uint8_t *message, uint16_t *messa
 enum kit_protocol_status kit_board_discover(bool enabled)
 {
     hardware_interface_discover();
+    // The device indexes may have changed
+#ifdef KIT_PROTOCOL_POWER
+    memset(g_kit_device_power, 0, sizeof(g_kit_device_power));
+#endif // KIT_PROTOCOL_POWER
+#ifdef KIT_PROTOCOL_TALK_ASYNC
+    memset(g_kit_async_tickets, 0, sizeof(g_kit_async_tickets));
+    memset(g_kit_device_queues, 0, sizeof(g_kit_device_queues));
+    g_kit_async_queued = 0;
+#endif // KIT_PROTOCOL_TALK_ASYNC
     return KIT_STATUS_SUCCESS;
 }
 
@@ -251,28 +593,64 @@ enum kit_protocol_status kit_board_application(uint32_t device_id, uint8_t *mess
     return KIT_STATUS_SUCCESS;
 }
 
-enum kit_protocol_status kit_device_idle(uint32_t device_id)
+#ifdef KIT_PROTOCOL_TIMING
+enum kit_protocol_status kit_board_timing(uint8_t *message, uint16_t *message_length)
 {
-    enum kit_protocol_status status = !KIT_STATUS_SUCCESS;
-    device_info_t *select_handle;
-    device_type_t device_type = DEVICE_TYPE_UNKNOWN;
-    uint8_t i;
+    const struct kit_execution_estimate *estimate;
+    uint16_t length = 0;
+    uint8_t index;
+
+    if ((*message_length != 0) && (message[0] == KIT_EXECUTION_RESET))
+    {
+        memset(g_kit_execution_estimates, 0, sizeof(g_kit_execution_estimates));
+        memset(g_kit_wake_latency, 0, sizeof(g_kit_wake_latency));
+        g_kit_execution_estimate_next = 0;
+        *message_length = 0;
+        return KIT_STATUS_SUCCESS;
+    }
 
-    for (i = 0; i < MAX_DISCOVER_DEVICES; i++)
+    // <address><bus><opcode><mode><count:2><average us:4><max us:4> of each learned command, big endian
+    for (index = 0; index < KIT_EXECUTION_ESTIMATES; index++)
     {
-        select_handle = get_device_info(i);
-        if (select_handle->address == device_id)
+        estimate = &g_kit_execution_estimates[index];
+        if (estimate->count == 0)
         {
-            device_type = select_handle->device_type;
-            break;
+            continue;
         }
+
+        message[length++] = estimate->address;
+        message[length++] = estimate->bus_type;
+        message[length++] = estimate->opcode;
+        message[length++] = estimate->mode;
+        message[length++] = (uint8_t)(estimate->count >> 8);
+        message[length++] = (uint8_t)estimate->count;
+        message[length++] = (uint8_t)(estimate->average_us >> 24);
+        message[length++] = (uint8_t)(estimate->average_us >> 16);
+        message[length++] = (uint8_t)(estimate->average_us >> 8);
+        message[length++] = (uint8_t)estimate->average_us;
+        message[length++] = (uint8_t)(estimate->max_us >> 24);
+        message[length++] = (uint8_t)(estimate->max_us >> 16);
+        message[length++] = (uint8_t)(estimate->max_us >> 8);
+        message[length++] = (uint8_t)estimate->max_us;
     }
 
+    *message_length = length;
+
+    return KIT_STATUS_SUCCESS;
+}
+#endif // KIT_PROTOCOL_TIMING
+
+enum kit_protocol_status kit_device_idle(uint32_t device_id)
+{
+    enum kit_protocol_status status = !KIT_STATUS_SUCCESS;
+    const device_info_t *select_handle = kit_device_get_info(device_id);
+    const device_type_t device_type = (select_handle != NULL) ? select_handle->device_type : DEVICE_TYPE_UNKNOWN;
+
     // Idle is not supported for ECC204,TA010,SHA104,SHA105,SHA106,RNG90,ECC206 devices
     if (check_idle_support(device_type))
     {
-        command_separate = 1;
-        status = g_kit_hal_interface.idle(device_id);
+        status = kit_device_get_hal(select_handle)->idle(device_id);
+        kit_device_track_power(select_handle, KIT_POWER_IDLE, KIT_TOKEN_IDLE, status);
     }
 
     return status;
@@ -280,38 +658,165 @@ enum kit_protocol_status kit_device_idle(uint32_t device_id)
 
 enum kit_protocol_status kit_device_sleep(uint32_t device_id)
 {
-    command_separate = 1;
-    return g_kit_hal_interface.sleep(device_id);
+    const device_info_t *select_handle = kit_device_get_info(device_id);
+    const enum kit_protocol_status status = kit_device_get_hal(select_handle)->sleep(device_id);
+
+    kit_device_track_power(select_handle, KIT_POWER_ASLEEP, KIT_TOKEN_SLEEP, status);
+
+    return status;
+}
+
+/** \brief Returns the current time in milliseconds.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The current time, always 0 without KIT_HAL_TIMER
+ */
+static uint32_t kit_device_get_time(void)
+{
+#ifdef KIT_HAL_TIMER
+    return kit_get_time_ms();
+#else
+    return 0;
+#endif // KIT_HAL_TIMER
 }
 
-enum kit_protocol_status kit_device_wake(uint32_t device_id, uint8_t *message, uint16_t *length)
+/** \brief Returns how long a device was waited for. The delays wait at least the
+ *         time they were given, rounded up to milliseconds without KIT_HAL_DELAY_US,
+ *         and with KIT_HAL_TIMER the clock also counts the time spent on the bus.
+ *
+ *  \param[in]    start_time             The time the wait started, in milliseconds
+ *                delayed                The sum of the delays applied since then, in microseconds
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The time waited, in microseconds
+ */
+static uint32_t kit_device_get_waited(uint32_t start_time, uint32_t delayed)
+{
+#ifdef KIT_HAL_TIMER
+    // The first millisecond tick may come right after the start
+    const uint32_t elapsed_ms = kit_get_time_ms() - start_time;
+    const uint32_t elapsed = (elapsed_ms > 1) ? ((elapsed_ms - 1) * 1000) : 0;
+
+    return (elapsed > delayed) ? elapsed : delayed;
+#else
+    (void)start_time;
+
+    return delayed;
+#endif // KIT_HAL_TIMER
+}
+
+/** \brief Sends a wake token to a device and polls its wake response.
+ *
+ *  \param[in]    device_id              The device address
+ *                select_handle          The device information, NULL when not discovered
+ *
+ *  \param[out]   message                The wake response
+ *                length                 The length of the wake response
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+static enum kit_protocol_status kit_device_wake_response(uint32_t device_id, const device_info_t *select_handle,
+                                                         uint8_t *message, uint16_t *length)
 {
     enum kit_protocol_status status = !KIT_STATUS_SUCCESS;
-    uint8_t wake_max_delay_time = 15;
+    const struct kit_hal_interface *hal = kit_device_get_hal(select_handle);
+    device_type_t device_type = DEVICE_TYPE_UNKNOWN;
+    interface_id_t bus_type = DEVKIT_IF_UNKNOWN;
+    uint16_t *latency;
+    uint32_t poll_delay = KIT_WAKE_POLL_MIN_US;
+    uint32_t start_time;
+    uint32_t waited;
+
+    if (select_handle != NULL)
+    {
+        device_type = (select_handle->device_type <= DEVICE_TYPE_SHA106) ? select_handle->device_type : DEVICE_TYPE_UNKNOWN;
+        bus_type = (select_handle->bus_type < DEVKIT_IF_LAST) ? select_handle->bus_type : DEVKIT_IF_UNKNOWN;
+    }
+    latency = &g_kit_wake_latency[device_type][bus_type];
+
+    // Sleep a little less than the expected latency before the first poll, so the
+    // learned latency keeps narrowing down to the device one
+    waited = (*latency != 0) ? *latency : get_device_wake_delay(device_type, bus_type);
+    waited -= (waited / 8);
+    waited = (waited >= KIT_WAKE_POLL_MIN_US) ? waited : 0;
+
+    hal->wake(device_id);
+    start_time = kit_device_get_time();
+    if (waited > 0)
+    {
+        kit_delay_us(waited);
+        waited = kit_device_get_waited(start_time, KIT_DELAY_US_APPLIED(waited));
+    }
 
-    *length = 4;
-    g_kit_hal_interface.wake(device_id);
-    do
+    for (;;)
     {
-        if ((status = g_kit_hal_interface.receive(device_id, message, length)) == KIT_STATUS_SUCCESS)
+        *length = 4;
+        if ((status = hal->receive(device_id, message, length)) == KIT_STATUS_SUCCESS)
         {
             break;
         }
 
-        kit_delay_ms(2);
-    } while (wake_max_delay_time-- > 0);
+        if (waited >= KIT_WAKE_TIMEOUT_US)
+        {
+            return status;
+        }
+
+        // Back off exponentially once the device is late
+        kit_delay_us(poll_delay);
+        waited = kit_device_get_waited(start_time, waited + KIT_DELAY_US_APPLIED(poll_delay));
+        poll_delay = ((poll_delay * 2) < KIT_WAKE_POLL_MAX_US) ? (poll_delay * 2) : KIT_WAKE_POLL_MAX_US;
+    }
+
+    // Learn the latency, the device was ready sooner when the first poll succeeded,
+    // otherwise it was late and the wait includes part of the last poll interval
+    if ((*latency != 0) && (poll_delay != KIT_WAKE_POLL_MIN_US))
+    {
+        waited = ((3 * (uint32_t)*latency) + waited) / 4;
+    }
+    *latency = (uint16_t)((waited == 0) ? 1 : ((waited < UINT16_MAX) ? waited : UINT16_MAX));
 
     return status;
 }
 
-enum kit_protocol_status kit_device_receive(uint32_t device_id, uint8_t *message, uint16_t *length)
+enum kit_protocol_status kit_device_wake(uint32_t device_id, uint8_t *message, uint16_t *length)
 {
-    enum kit_protocol_status status = KIT_STATUS_FAILURE;
-    status = g_kit_hal_interface.receive(device_id, message, length);
-    if (*length > 1)
+    enum kit_protocol_status status;
+    const device_info_t *select_handle = kit_device_get_info(device_id);
+
+    // The device is still awake, answer its wake response without bus traffic
+    if (kit_device_is_awake(select_handle))
     {
-        command_separate = 1;
+        memcpy(message, g_kit_wake_response, sizeof(g_kit_wake_response));
+        *length = sizeof(g_kit_wake_response);
+        return KIT_STATUS_SUCCESS;
     }
+
+    status = kit_device_wake_response(device_id, select_handle, message, length);
+
+    // Only the wake response tells the watchdog just started
+    kit_device_track_power(select_handle, ((*length >= 2) && (message[1] == g_kit_wake_response[1])) ? KIT_POWER_AWAKE : KIT_POWER_UNKNOWN,
+                           KIT_TOKEN_WAKE, status);
+
+    return status;
+}
+
+enum kit_protocol_status kit_device_receive(uint32_t device_id, uint8_t *message, uint16_t *length)
+{
+    const device_info_t *select_handle = kit_device_get_info(device_id);
+    const enum kit_protocol_status status = kit_device_get_hal(select_handle)->receive(device_id, message, length);
+
+    kit_device_track_power(select_handle, KIT_POWER_UNKNOWN, KIT_TOKEN_COMMAND, status);
+
     return status;
 }
 
@@ -319,133 +824,777 @@ enum kit_protocol_status kit_device_send(uint32_t device_id, uint8_t *message, u
 {
     enum kit_protocol_status status;
     const char *command_string = NULL;
-    device_info_t *select_handle;
-    device_type_t dev_type = DEVICE_TYPE_UNKNOWN;
-    uint8_t i;
+    const device_info_t *select_handle = kit_device_get_info(device_id);
+    const device_type_t dev_type = (select_handle != NULL) ? select_handle->device_type : DEVICE_TYPE_UNKNOWN;
     uint8_t opcode;
 
-    for (i = 0; i < MAX_DISCOVER_DEVICES; i++)
+    opcode = (DEVICE_TYPE_TA100 == dev_type) ? message[3] : message[1];
+    command_string = get_command_string(dev_type, opcode);
+
+    kit_trace_record_text(KIT_TRACE_COMMAND, device_id, command_string);
+
+    status = kit_device_get_hal(select_handle)->send(device_id, message, length);
+    kit_device_track_power(select_handle, KIT_POWER_UNKNOWN, KIT_TOKEN_COMMAND, status);
+    *length = 0; // For send command response will be kitstatus "00()\n"
+    return status;
+}
+
+#ifdef KIT_HAL_TALK_SCHEDULE
+/** \brief Finds the learned execution time of a device command.
+ *
+ *  \param[in]    device                 The device information
+ *                opcode                 The command opcode
+ *                mode                   The command mode (param1)
+ *                allocate               Whether to use a new entry when there is none
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the learned execution time, NULL when there is none (always without KIT_PROTOCOL_TIMING)
+ */
+static struct kit_execution_estimate *kit_device_find_estimate(const device_info_t *device, uint8_t opcode, uint8_t mode,
+                                                               bool allocate)
+{
+#ifdef KIT_PROTOCOL_TIMING
+    struct kit_execution_estimate *estimate;
+    struct kit_execution_estimate *unused = NULL;
+    uint8_t index;
+
+    for (index = 0; index < KIT_EXECUTION_ESTIMATES; index++)
     {
-        select_handle = get_device_info(i);
-        if (select_handle->address == device_id)
+        estimate = &g_kit_execution_estimates[index];
+        if (estimate->count == 0)
         {
-            dev_type = select_handle->device_type;
-            break;
+            unused = (unused != NULL) ? unused : estimate;
+        }
+        else if ((estimate->address == device->address) && (estimate->bus_type == (uint8_t)device->bus_type) &&
+                 (estimate->opcode == opcode) && (estimate->mode == mode))
+        {
+            return estimate;
         }
     }
 
-    opcode = (DEVICE_TYPE_TA100 == dev_type) ? message[3] : message[1];
-    command_string = get_command_string(dev_type, opcode);
+    if (!allocate)
+    {
+        return NULL;
+    }
+
+    if (unused == NULL)
+    {
+        unused = &g_kit_execution_estimates[g_kit_execution_estimate_next];
+        g_kit_execution_estimate_next = (uint8_t)((g_kit_execution_estimate_next + 1) % KIT_EXECUTION_ESTIMATES);
+    }
+
+    unused->address = device->address;
+    unused->bus_type = (uint8_t)device->bus_type;
+    unused->opcode = opcode;
+    unused->mode = mode;
+    unused->count = 0;
+    unused->average_us = 0;
+    unused->max_us = 0;
+
+    return unused;
+#else
+    (void)device;
+    (void)opcode;
+    (void)mode;
+    (void)allocate;
+
+    return NULL;
+#endif // KIT_PROTOCOL_TIMING
+}
+
+/** \brief Sends a command to a count byte framed device, sleeps its expected execution
+ *         time then polls its response until the longest execution time is over.
+ *         The execution time of the polled devices is learned from the first
+ *         successful poll, it replaces the typical one once measured.
+ *
+ *  \param[in]    device_id              The device address
+ *                device                 The device information
+ *                execution_time         The command execution time
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] message                As input, the command packet
+ *                                       As output, the response packet
+ *                length                 As input, the length of the command packet
+ *                                       As output, the length of the response packet
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+static enum kit_protocol_status kit_device_execute(uint32_t device_id, const device_info_t *device,
+                                                   const opcode_execution_time_t *execution_time, uint8_t *message, uint16_t *length)
+{
+    enum kit_protocol_status status;
+    const struct kit_hal_interface *hal = kit_device_get_hal(device);
+    const uint32_t max_time = (uint32_t)execution_time->max_time_ms * 1000;
+    const uint8_t opcode = message[ECC108_OPCODE_IDX];
+    const uint8_t mode = message[ECC108_PARAM1_IDX];
+    struct kit_execution_estimate *estimate = NULL;
+    uint32_t start_time;
+    uint32_t waited;
+    bool first_poll = true;
+
+    if ((status = hal->send(device_id, message, length)) != KIT_STATUS_SUCCESS)
+    {
+        return status;
+    }
 
-    if (command_string)
+    if (device->is_no_poll)
     {
-        printf("........%s\r\n", command_string);
+        // The devices which are not polled respond once the longest execution time is over
+        waited = max_time;
+    }
+    else if ((estimate = kit_device_find_estimate(device, opcode, mode, false)) != NULL)
+    {
+        // Poll a little before the learned time, so it keeps narrowing down to the device one
+        waited = estimate->average_us - (estimate->average_us / 8);
     }
     else
     {
-        printf("%s", "\r\n");
+        waited = execution_time->typical_time_us;
+    }
+    start_time = kit_device_get_time();
+    kit_delay_us(waited);
+    waited = kit_device_get_waited(start_time, KIT_DELAY_US_APPLIED(waited));
+
+    for (;;)
+    {
+        // The count byte limits the response size
+        *length = UINT8_MAX;
+        if (((status = hal->receive(device_id, message, length)) == KIT_STATUS_SUCCESS) ||
+            device->is_no_poll || (waited >= max_time))
+        {
+            break;
+        }
+
+        kit_delay_us(KIT_EXECUTION_POLL_US);
+        waited = kit_device_get_waited(start_time, waited + KIT_DELAY_US_APPLIED(KIT_EXECUTION_POLL_US));
+        first_poll = false;
+    }
+
+    if ((status == KIT_STATUS_SUCCESS) && !device->is_no_poll &&
+        ((estimate != NULL) || ((estimate = kit_device_find_estimate(device, opcode, mode, true)) != NULL)))
+    {
+        // The command was done sooner when the first poll succeeded, otherwise the wait
+        // includes part of the last poll interval
+        estimate->average_us = ((estimate->count == 0) || first_poll) ? waited : (((3 * estimate->average_us) + waited) / 4);
+        estimate->max_us = (waited > estimate->max_us) ? waited : estimate->max_us;
+        estimate->count = (estimate->count < UINT16_MAX) ? (estimate->count + 1) : UINT16_MAX;
     }
 
-    status = g_kit_hal_interface.send(device_id, message, length);
-    *length = 0; // For send command response will be kitstatus "00()\n"
     return status;
 }
+#endif // KIT_HAL_TALK_SCHEDULE
 
 enum kit_protocol_status kit_device_talk(uint32_t device_id, uint8_t *message, uint16_t *length)
 {
+    enum kit_protocol_status status;
     const char *command_string = NULL;
-    device_info_t *select_handle;
-    device_type_t dev_type = DEVICE_TYPE_UNKNOWN;
-    uint8_t i;
+    const device_info_t *select_handle = kit_device_get_info(device_id);
+    const device_type_t dev_type = (select_handle != NULL) ? select_handle->device_type : DEVICE_TYPE_UNKNOWN;
+    const opcode_execution_time_t *execution_time = NULL;
+
+    command_string = get_command_string(dev_type, message[1]);
+
+    kit_trace_record_text(KIT_TRACE_COMMAND, device_id, command_string);
+
+#ifdef KIT_HAL_TALK_SCHEDULE
+    // The TA10x HAL polls the device status itself
+    if ((*length > ECC108_PARAM1_IDX) && !check_ta_device(dev_type))
+    {
+        execution_time = get_device_execution_time(dev_type, message[ECC108_OPCODE_IDX], message[ECC108_PARAM1_IDX]);
+    }
+#endif // KIT_HAL_TALK_SCHEDULE
+
+    if (execution_time == NULL)
+    {
+        status = kit_device_get_hal(select_handle)->talk(device_id, message, length);
+    }
+#ifdef KIT_HAL_TALK_SCHEDULE
+    else
+    {
+        status = kit_device_execute(device_id, select_handle, execution_time, message, length);
+    }
+#endif // KIT_HAL_TALK_SCHEDULE
+
+    kit_device_track_power(select_handle, KIT_POWER_UNKNOWN, KIT_TOKEN_COMMAND, status);
+
+    return status;
+}
+
+#ifdef KIT_PROTOCOL_TALK_ASYNC
+/** \brief Starts the command of a device:talk_async ticket.
+ *
+ *  \param[in]    device                 The device of the command
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ticket                 The ticket, started or done
+ *
+ *  \return None
+ */
+static void kit_async_start(struct kit_async_ticket *ticket, const device_info_t *device)
+{
+    enum kit_protocol_status status;
+    const struct kit_hal_interface *hal = kit_device_get_hal(device);
+#ifdef KIT_HAL_TIMER
+    const opcode_execution_time_t *execution_time = NULL;
+
+    if ((ticket->length > ECC108_PARAM1_IDX) && !check_ta_device(device->device_type))
+    {
+        execution_time = get_device_execution_time(device->device_type, ticket->data[ECC108_OPCODE_IDX], ticket->data[ECC108_PARAM1_IDX]);
+    }
+#endif // KIT_HAL_TIMER
+
+    ticket->start_time = kit_device_get_time();
+    ticket->ready_time_ms = 0;
+    ticket->max_time_ms = 0;
 
-    for (i = 0; i < MAX_DISCOVER_DEVICES; i++)
+    if (hal->talk_start != NULL)
+    {
+        kit_trace_record_text(KIT_TRACE_COMMAND, ticket->device_id, get_command_string(device->device_type, ticket->data[1]));
+        ticket->mode = KIT_ASYNC_HAL;
+#ifdef KIT_HAL_TIMER
+        ticket->max_time_ms = (execution_time != NULL) ? execution_time->max_time_ms : 0;
+#endif // KIT_HAL_TIMER
+        status = hal->talk_start(ticket->device_id, ticket->data, &ticket->length);
+    }
+#ifdef KIT_HAL_TIMER
+    else if ((execution_time != NULL) && !device->is_no_poll)
     {
-        select_handle = get_device_info(i);
-        if (select_handle->address == device_id)
+        // Without a clock the response polling has no timeout, the command then completes at once
+        kit_trace_record_text(KIT_TRACE_COMMAND, ticket->device_id, get_command_string(device->device_type, ticket->data[1]));
+        ticket->mode = KIT_ASYNC_POLLED;
+        ticket->ready_time_ms = execution_time->typical_time_us / 1000;
+        ticket->max_time_ms = execution_time->max_time_ms;
+        status = hal->send(ticket->device_id, ticket->data, &ticket->length);
+    }
+#endif // KIT_HAL_TIMER
+    else
+    {
+        // Without a split talk the command completes now (Ex. the TA10x commands), the
+        // ticket keeps the response when it fits
+        ticket->mode = KIT_ASYNC_DONE;
+        memcpy(g_kit_async_response, ticket->data, ticket->length);
+        ticket->status = kit_device_talk(ticket->device_id, g_kit_async_response, &ticket->length);
+        if ((ticket->status == KIT_STATUS_SUCCESS) && (ticket->length > sizeof(ticket->data)))
         {
-            dev_type = select_handle->device_type;
-            break;
+            ticket->status = KIT_STATUS_SMALL_BUFFER;
         }
+        else if (ticket->status == KIT_STATUS_SUCCESS)
+        {
+            memcpy(ticket->data, g_kit_async_response, ticket->length);
+        }
+        status = KIT_STATUS_SUCCESS;
     }
 
-    command_string = get_command_string(dev_type, message[1]);
+    if (status != KIT_STATUS_SUCCESS)
+    {
+        ticket->mode = KIT_ASYNC_DONE;
+        ticket->status = status;
+        kit_device_track_power(device, KIT_POWER_UNKNOWN, KIT_TOKEN_COMMAND, status);
+    }
+
+    if ((ticket->mode == KIT_ASYNC_DONE) && (ticket->status != KIT_STATUS_SUCCESS))
+    {
+        ticket->length = 0;
+    }
+}
+
+/** \brief Completes the command of a started device:talk_async ticket, without waiting.
+ *
+ *  \param[in]    device                 The device of the command
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ticket                 The ticket, done once the device responded
+ *
+ *  \return None
+ */
+static void kit_async_complete(struct kit_async_ticket *ticket, const device_info_t *device)
+{
+    enum kit_protocol_status status;
+    const struct kit_hal_interface *hal = kit_device_get_hal(device);
+    const uint32_t elapsed = kit_device_get_time() - ticket->start_time;
 
-    if (command_string)
+    if (ticket->mode == KIT_ASYNC_HAL)
     {
-        printf("........%s\r\n", command_string);
+        ticket->length = sizeof(ticket->data);
+        status = hal->talk_complete(ticket->device_id, ticket->data, &ticket->length);
+        if ((status == KIT_STATUS_PENDING) && (ticket->max_time_ms != 0) && (elapsed >= ticket->max_time_ms))
+        {
+            // The response is lost (Ex. read by a device:talk meanwhile), the commands
+            // queued behind it must not wait forever
+            status = KIT_STATUS_RX_NO_RESPONSE;
+        }
     }
     else
     {
-        printf("%s", "\r\n");
+        // There is no bus traffic before the device is expected to be done
+        if (elapsed < ticket->ready_time_ms)
+        {
+            return;
+        }
+
+        // The count byte limits the response size, the ticket data may be smaller
+        ticket->length = (sizeof(ticket->data) < UINT8_MAX) ? sizeof(ticket->data) : UINT8_MAX;
+        status = hal->receive(ticket->device_id, ticket->data, &ticket->length);
+        if ((status != KIT_STATUS_SUCCESS) && ((ticket->max_time_ms == 0) || (elapsed < ticket->max_time_ms)))
+        {
+            status = KIT_STATUS_PENDING;
+        }
+    }
+
+    if (status == KIT_STATUS_PENDING)
+    {
+        return;
+    }
+
+    ticket->mode = KIT_ASYNC_DONE;
+    ticket->status = status;
+    if (status != KIT_STATUS_SUCCESS)
+    {
+        ticket->length = 0;
     }
 
-    return g_kit_hal_interface.talk(device_id, message, length);
+    kit_device_track_power(device, KIT_POWER_UNKNOWN, KIT_TOKEN_COMMAND, status);
 }
 
-enum kit_protocol_status kit_device_mem_write(uint32_t device_id, uint8_t *message, uint16_t *length)
+/** \brief Runs the device:talk_async commands of a device queue as far as they go
+ *         without waiting: the running command is completed, then the next one is
+ *         started.
+ *
+ *  \param[in]    device_index           The device_info index of the device
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void kit_device_schedule_queue(uint8_t device_index)
 {
-    return KIT_STATUS_SUCCESS;
+    struct kit_device_queue *queue = &g_kit_device_queues[device_index];
+    const device_info_t *device = get_device_info(device_index);
+    struct kit_async_ticket *ticket;
+
+    while (queue->head != 0)
+    {
+        ticket = &g_kit_async_tickets[queue->head - 1];
+
+        if (ticket->mode == KIT_ASYNC_QUEUED)
+        {
+            kit_async_start(ticket, device);
+        }
+        else
+        {
+            kit_async_complete(ticket, device);
+        }
+
+        if (ticket->mode != KIT_ASYNC_DONE)
+        {
+            // The device is executing the command
+            break;
+        }
+
+        // The response waits for device:poll, the next command of the device can start
+        ticket->done_time = kit_device_get_time();
+        if (ticket->cancelled)
+        {
+            ticket->mode = KIT_ASYNC_FREE;
+        }
+        queue->head = ticket->next;
+        if (queue->head == 0)
+        {
+            queue->tail = 0;
+        }
+        g_kit_async_queued--;
+    }
 }
 
-enum kit_protocol_status kit_device_mem_read(uint32_t device_id, uint8_t *message, uint16_t *length)
+/** \brief Frees the tickets of the completed commands whose response was not polled
+ *         within KIT_ASYNC_EXPIRY_MS, so an abandoned ticket is not kept forever.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void kit_async_expire(void)
 {
-    return KIT_STATUS_SUCCESS;
+#ifdef KIT_HAL_TIMER
+    const uint32_t now = kit_get_time_ms();
+    uint8_t index;
+
+    for (index = 0; index < KIT_ASYNC_TICKETS; index++)
+    {
+        if ((g_kit_async_tickets[index].mode == KIT_ASYNC_DONE) &&
+            ((now - g_kit_async_tickets[index].done_time) >= KIT_ASYNC_EXPIRY_MS))
+        {
+            g_kit_async_tickets[index].mode = KIT_ASYNC_FREE;
+        }
+    }
+#endif // KIT_HAL_TIMER
 }
 
-void print_kit_traffic(const char *traffic_header)
+/** \brief Finds the ticket of a device:talk_async command.
+ *
+ *  \param[in]    number                 The ticket number returned to the host
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the ticket, NULL when the number is not the one of a ticket in use
+ */
+static struct kit_async_ticket *kit_async_find_ticket(uint8_t number)
 {
-    char *traffic_data;
-    char *ptr;
+    struct kit_async_ticket *ticket;
 
-    if ((NULL == host_msg_buffer_length) || (NULL == host_msg_buffer))
+    if ((number & KIT_ASYNC_TICKET_INDEX) >= KIT_ASYNC_TICKETS)
     {
-        return;
+        return NULL;
+    }
+
+    ticket = &g_kit_async_tickets[number & KIT_ASYNC_TICKET_INDEX];
+    if ((ticket->mode == KIT_ASYNC_FREE) || ticket->cancelled || (ticket->number != number))
+    {
+        return NULL;
     }
 
-    if (NULL == (traffic_data = malloc(*host_msg_buffer_length)))
+    return ticket;
+}
+
+void kit_device_schedule(void)
+{
+    uint8_t device_index;
+
+    kit_async_expire();
+
+    if (g_kit_async_queued == 0)
     {
         return;
     }
 
-    memcpy(traffic_data, host_msg_buffer, *host_msg_buffer_length);
+    // While a device executes its command, the commands of the other devices are started
+    for (device_index = 0; device_index < MAX_DISCOVER_DEVICES; device_index++)
+    {
+        if (g_kit_device_queues[device_index].head == 0)
+        {
+            continue;
+        }
+
+        kit_device_schedule_queue(device_index);
+    }
+}
+
+enum kit_protocol_status kit_device_talk_async(uint32_t device_id, uint8_t *message, uint16_t *length)
+{
+    const device_info_t *select_handle = kit_device_get_info(device_id);
+    struct kit_async_ticket *ticket = NULL;
+    struct kit_device_queue *queue;
+    uint8_t index;
+
+    if (select_handle == NULL)
+    {
+        *length = 0;
+        return KIT_STATUS_NO_DEVICE;
+    }
+
+    if (*length > sizeof(ticket->data))
+    {
+        *length = 0;
+        return KIT_STATUS_INVALID_SIZE;
+    }
+
+    kit_async_expire();
+
+    for (index = 0; index < KIT_ASYNC_TICKETS; index++)
+    {
+        if (g_kit_async_tickets[index].mode == KIT_ASYNC_FREE)
+        {
+            ticket = &g_kit_async_tickets[index];
+            break;
+        }
+    }
+
+    if (ticket == NULL)
+    {
+        *length = 0;
+        return KIT_STATUS_FAILURE;
+    }
+
+    g_kit_async_issued++;
+    ticket->mode = KIT_ASYNC_QUEUED;
+    ticket->number = (uint8_t)((g_kit_async_issued << 4) | index);
+    ticket->next = 0;
+    ticket->cancelled = false;
+    ticket->device_index = (uint8_t)(select_handle - get_device_info(0));
+    ticket->device_id = device_id;
+    ticket->length = *length;
+    memcpy(ticket->data, message, *length);
+
+    // The commands of a device run in the order they were received
+    queue = &g_kit_device_queues[ticket->device_index];
+    if (queue->tail != 0)
+    {
+        g_kit_async_tickets[queue->tail - 1].next = (uint8_t)(index + 1);
+    }
+    else
+    {
+        queue->head = (uint8_t)(index + 1);
+    }
+    queue->tail = (uint8_t)(index + 1);
+    g_kit_async_queued++;
+
+    // The command starts now when its device is not busy
+    kit_device_schedule();
+
+    message[0] = ticket->number;
+    *length = 1;
+
+    return KIT_STATUS_SUCCESS;
+}
+
+enum kit_protocol_status kit_device_poll(uint32_t device_id, uint8_t *message, uint16_t *length)
+{
+    enum kit_protocol_status status;
+    struct kit_async_ticket *ticket;
+
+    (void)device_id;
+
+    if ((*length != 1) || ((ticket = kit_async_find_ticket(message[0])) == NULL))
+    {
+        *length = 0;
+        return KIT_STATUS_INVALID_ID;
+    }
+
+    kit_device_schedule();
+
+    if (ticket->mode == KIT_ASYNC_FREE)
+    {
+        // The response expired
+        *length = 0;
+        return KIT_STATUS_INVALID_ID;
+    }
+
+    if (ticket->mode != KIT_ASYNC_DONE)
+    {
+        *length = 0;
+        return KIT_STATUS_PENDING;
+    }
+
+    status = ticket->status;
+    *length = ticket->length;
+    memcpy(message, ticket->data, ticket->length);
+    ticket->mode = KIT_ASYNC_FREE;
+
+    return status;
+}
+
+enum kit_protocol_status kit_device_cancel(uint32_t device_id, uint8_t *message, uint16_t *length)
+{
+    struct kit_async_ticket *ticket;
+    struct kit_device_queue *queue;
+    uint8_t previous = 0;
+    uint8_t current;
+    uint8_t index;
+
+    (void)device_id;
 
-    ptr = strchr(traffic_data, KIT_MESSAGE_DELIMITER);
-    if (ptr != NULL)
+    if ((*length != 1) || ((ticket = kit_async_find_ticket(message[0])) == NULL))
     {
-        *ptr = '\0';
+        *length = 0;
+        return KIT_STATUS_INVALID_ID;
     }
-    if (command_separate)
+
+    *length = 0;
+    index = (uint8_t)((ticket - g_kit_async_tickets) + 1);
+    queue = &g_kit_device_queues[ticket->device_index];
+
+    if (ticket->mode == KIT_ASYNC_QUEUED)
     {
-        command_separate = 0;
-        printf("%s: %s\r\n\n", traffic_header, traffic_data);
+        // The command was not started, it leaves its device queue
+        for (current = queue->head; current != index; current = g_kit_async_tickets[current - 1].next)
+        {
+            previous = current;
+        }
+        if (previous == 0)
+        {
+            queue->head = ticket->next;
+        }
+        else
+        {
+            g_kit_async_tickets[previous - 1].next = ticket->next;
+        }
+        if (queue->tail == index)
+        {
+            queue->tail = previous;
+        }
+        g_kit_async_queued--;
+        ticket->mode = KIT_ASYNC_FREE;
     }
-    else if (command_talk)
+    else if (ticket->mode == KIT_ASYNC_DONE)
     {
-        command_talk = 0;
-        printf("%s: %s", traffic_header, traffic_data);
+        ticket->mode = KIT_ASYNC_FREE;
     }
     else
     {
-        printf("%s: %s\r\n", traffic_header, traffic_data);
+        // The device executes the command, its response is dropped once read
+        ticket->cancelled = true;
     }
 
-    // Free the allocated memory
-    free(traffic_data);
+    return KIT_STATUS_SUCCESS;
+}
+#endif // KIT_PROTOCOL_TALK_ASYNC
+
+enum kit_protocol_status kit_device_mem_write(uint32_t device_id, uint8_t *message, uint16_t *length)
+{
+    return KIT_STATUS_SUCCESS;
+}
+
+enum kit_protocol_status kit_device_mem_read(uint32_t device_id, uint8_t *message, uint16_t *length)
+{
+    return KIT_STATUS_SUCCESS;
+}
+
+/** \brief Writes the host traffic in the binary capture, with the selected device.
+ *
+ *  \param[in]    ctx                  The interpreter context
+ *                direction            The traffic direction
+ *                flags                The KIT_CAPTURE_FLAG_ record flags
+ *                data                 The traffic
+ *                length               The length of the traffic
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void capture_kit_traffic(const struct kit_interpreter_ctx *ctx, enum kit_trace_direction direction, uint8_t flags,
+                                const uint8_t *data, uint16_t length)
+{
+    const device_info_t *device = ctx->selected_device;
+
+    kit_capture_record(direction, ctx->selected_device_handle, (device != NULL) ? (uint8_t)device->bus_type : DEVKIT_IF_UNKNOWN,
+                       flags, data, length);
+}
+
+#ifdef KIT_PROTOCOL_PIPELINE
+/** \brief Records each message of a newline delimited traffic buffer in the trace.
+ *
+ *  \param[in]    direction            The traffic direction
+ *                buffer               The traffic messages
+ *                length               The length of the traffic messages
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void trace_kit_pipeline_traffic(enum kit_trace_direction direction, const char *buffer, uint16_t length)
+{
+    struct kit_interpreter_ctx *ctx = kit_interpreter_get_default_ctx();
+    const char *message = buffer;
+    const char *end = buffer + length;
+    const char *delimiter;
+
+    while ((delimiter = memchr(message, KIT_MESSAGE_DELIMITER, (size_t)(end - message))) != NULL)
+    {
+        kit_trace_record(direction, 0, ctx->selected_device_handle, (const uint8_t *)message, (uint16_t)(delimiter - message));
+        message = delimiter + 1;
+    }
 }
+#endif // KIT_PROTOCOL_PIPELINE
 
 void kit_protocol_task(void *params)
 {
+    struct kit_interpreter_ctx *ctx = kit_interpreter_get_default_ctx();
+#ifdef KIT_PROTOCOL_PIPELINE
+    uint16_t response_length = 0;
+#else
+    uint8_t trace_flags = 0;
+#endif // KIT_PROTOCOL_PIPELINE
+
+#ifdef KIT_PROTOCOL_TALK_ASYNC
+    // The queued device commands progress between the host messages
+    kit_device_schedule();
+#endif // KIT_PROTOCOL_TALK_ASYNC
+
+#ifndef KIT_TRACE_DRAIN_THREAD
+    if (!*host_message_received)
+    {
+        // Print the traffic trace while the host is idle, one record at a time
+        kit_trace_drain(1);
+        return;
+    }
+#endif // KIT_TRACE_DRAIN_THREAD
+
+    if (*host_message_received && ctx->binary_mode)
+    {
+        capture_kit_traffic(ctx, KIT_TRACE_RECEIVED, KIT_CAPTURE_FLAG_BINARY, host_msg_buffer, *host_msg_buffer_length);
+        // Handle the binary frame (enabled by board:binary(01)), the response replaces it
+        kit_interpreter_handle_binary_ctx(ctx, host_msg_buffer, host_msg_buffer_length);
+        capture_kit_traffic(ctx, KIT_TRACE_SENT, KIT_CAPTURE_FLAG_BINARY, host_msg_buffer, *host_msg_buffer_length);
+        // send response to host
+        g_kit_host_interface.send_device_response_to_host(&host_msg_buffer[0], *host_msg_buffer_length);
+        // reset the message buffer length
+        *host_msg_buffer_length = 0;
+        // reset the message received bool variable
+        *host_message_received = 0;
+        return;
+    }
+
+#ifdef KIT_PROTOCOL_PIPELINE
+    if (*host_message_received)
+    {
+        capture_kit_traffic(ctx, KIT_TRACE_RECEIVED, 0, host_msg_buffer, *host_msg_buffer_length);
+        trace_kit_pipeline_traffic(KIT_TRACE_RECEIVED, (char *)host_msg_buffer, *host_msg_buffer_length);
+        // Run every message of the host buffer and collect their responses
+        kit_interpreter_handle_pipeline_ctx(ctx, (char *)host_msg_buffer, *host_msg_buffer_length,
+                                            g_kit_pipeline_response, sizeof(g_kit_pipeline_response), &response_length);
+        capture_kit_traffic(ctx, KIT_TRACE_SENT, 0, (uint8_t *)g_kit_pipeline_response, response_length);
+        trace_kit_pipeline_traffic(KIT_TRACE_SENT, g_kit_pipeline_response, response_length);
+        // send all the responses to host at once
+        g_kit_host_interface.send_device_response_to_host((uint8_t *)g_kit_pipeline_response, response_length);
+        // reset the message buffer length
+        *host_msg_buffer_length = 0;
+        // reset the message received bool variable
+        *host_message_received = 0;
+    }
+#else
     if (*host_message_received)
     {
+        // The command name of the talk and send messages completes their trace line
         if ((strstr((char *)host_msg_buffer, ":t") != NULL) || (strstr((char *)host_msg_buffer, ":T") != NULL) || (strstr((char *)host_msg_buffer, ":send") != NULL))
         {
-            command_talk = 1;
+            trace_flags = KIT_TRACE_FLAG_CONTINUED;
         }
 
-        print_kit_traffic("Received");
+        capture_kit_traffic(ctx, KIT_TRACE_RECEIVED, 0, host_msg_buffer, *host_msg_buffer_length);
+        kit_trace_record(KIT_TRACE_RECEIVED, trace_flags, ctx->selected_device_handle, host_msg_buffer, *host_msg_buffer_length);
         // Parse the received message and send & receive command reponse to device
         kit_interpreter_handle_message((char *)host_msg_buffer, host_msg_buffer_length);
-        print_kit_traffic("Sent");
+        // Separate the device session traffic once the device is released or has responded
+        if ((ctx->message_command == KIT_COMMAND_DEVICE_IDLE) ||
+            (ctx->message_command == KIT_COMMAND_DEVICE_SLEEP) ||
+            ((ctx->message_command == KIT_COMMAND_DEVICE_RECEIVE) && (ctx->message_length > 2)))
+        {
+            trace_flags = KIT_TRACE_FLAG_SEPARATE;
+        }
+        else
+        {
+            trace_flags = 0;
+        }
+        capture_kit_traffic(ctx, KIT_TRACE_SENT, 0, host_msg_buffer, *host_msg_buffer_length);
+        kit_trace_record(KIT_TRACE_SENT, trace_flags, ctx->selected_device_handle, host_msg_buffer, *host_msg_buffer_length);
         // send response to host
         g_kit_host_interface.send_device_response_to_host(&host_msg_buffer[0], *host_msg_buffer_length);
         // reset the message buffer length
@@ -453,4 +1602,66 @@ void kit_protocol_task(void *params)
         // reset the message received bool variable
         *host_message_received = 0;
     }
-}
\ No newline at end of file
+#endif // KIT_PROTOCOL_PIPELINE
+}
+
+enum kit_protocol_status kit_device_transact(uint32_t device_id, uint8_t *message, uint16_t *length)
+{
+    enum kit_protocol_status status;
+    enum kit_protocol_status talk_status = KIT_STATUS_FAILURE;
+    enum kit_protocol_status token_status = KIT_STATUS_FAILURE;
+    uint8_t wake_response[sizeof(g_kit_wake_response)];
+    uint16_t wake_length = sizeof(wake_response);
+    uint16_t talk_length;
+    const uint8_t token = message[0];
+
+    if ((*length < 2) || (token > KIT_TRANSACT_SLEEP))
+    {
+        *length = 0;
+        return KIT_STATUS_INVALID_PARAM;
+    }
+
+    // The talk response follows the step statuses
+    talk_length = (uint16_t)(*length - 1);
+    memmove(&message[KIT_TRANSACT_HEADER_SIZE], &message[1], talk_length);
+
+    status = kit_device_wake(device_id, wake_response, &wake_length);
+    if (status == KIT_STATUS_SUCCESS)
+    {
+        talk_status = kit_device_talk(device_id, &message[KIT_TRANSACT_HEADER_SIZE], &talk_length);
+        if (talk_status != KIT_STATUS_SUCCESS)
+        {
+            talk_length = 0;
+        }
+
+        // The token is sent even when the talk failed, the device is then in a known state
+        switch (token)
+        {
+        case KIT_TRANSACT_IDLE:
+            token_status = kit_device_idle(device_id);
+            break;
+        case KIT_TRANSACT_SLEEP:
+            token_status = kit_device_sleep(device_id);
+            break;
+        default:
+            token_status = KIT_STATUS_SUCCESS;
+            break;
+        }
+    }
+    else
+    {
+        talk_length = 0;
+    }
+
+    message[0] = (uint8_t)status;
+    message[1] = (uint8_t)talk_status;
+    message[2] = (uint8_t)token_status;
+    *length = (uint16_t)(KIT_TRANSACT_HEADER_SIZE + talk_length);
+
+    if (status != KIT_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    return (talk_status != KIT_STATUS_SUCCESS) ? talk_status : token_status;
+}
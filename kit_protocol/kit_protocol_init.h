@@ -130,6 +130,24 @@ enum kit_protocol_status kit_board_discover(bool enabled);
  */
 enum kit_protocol_status kit_board_application(uint32_t device_id, uint8_t *message, uint16_t *message_length);
 
+/** \brief The function dumps or clears the learned device execution times
+ *
+ *  \note  The execution times are learned with KIT_PROTOCOL_TIMING.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] message                As input, 01 to clear the learned execution times,
+ *                                       otherwise they are dumped
+ *                                       As output, references to the learned execution times
+ *                message_length         As input, references to size of message (number of bytes)
+ *                                       As output, references to size of learned execution times
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+enum kit_protocol_status kit_board_timing(uint8_t *message, uint16_t *message_length);
+
 /** \brief This function sends a idle command to the device
  *
  *  \param[in]    device_id              references to device address
@@ -194,6 +212,13 @@ enum kit_protocol_status kit_device_receive(uint32_t device_id, uint8_t * messag
 enum kit_protocol_status kit_device_send(uint32_t device_id, uint8_t * message, uint16_t * length);
 
 /** \brief This function send a talk command to the device.
+ *
+ *  \note  The command goes through the talk of the device HAL. With
+ *         KIT_HAL_TALK_SCHEDULE the commands of the execution time tables
+ *         (except the TA10x ones) are instead sent with the HAL send, then
+ *         their response is polled with the HAL receive once the execution
+ *         time is over, so a HAL talk doing more than send and receive is
+ *         not called for them.
  *
  *  \param[in]    device_id              reference to device address
  *                message                references to pointer to space to bytes to send
@@ -207,6 +232,99 @@ enum kit_protocol_status kit_device_send(uint32_t device_id, uint8_t * message,
  */
 enum kit_protocol_status kit_device_talk(uint32_t device_id, uint8_t * message, uint16_t * length);
 
+/** \brief This function starts a talk command without waiting for the device to
+ *         execute it, device:poll returns its response.
+ *
+ *  \note  The commands of each device are queued and run in order, the commands of
+ *         the other devices run while a device executes its command. Without a HAL
+ *         talk_start, the TA10x commands (and all of them without KIT_HAL_TIMER) run
+ *         at once, the task waits for their execution. The talk_async commands are
+ *         compiled with KIT_PROTOCOL_TALK_ASYNC.
+ *
+ *  \param[in]    device_id              reference to device address
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] message                As input, the command packet
+ *                                       As output, the ticket of the command
+ *                length                 As input, references to size of message (number of bytes)
+ *                                       As output, references to size of the ticket
+ *
+ *  \return KIT_STATUS_SUCCESS once queued, KIT_STATUS_FAILURE when all the tickets are
+ *          in use, otherwise an error code
+ */
+enum kit_protocol_status kit_device_talk_async(uint32_t device_id, uint8_t * message, uint16_t * length);
+
+/** \brief This function runs the queued device:talk_async commands, without waiting
+ *         for the devices: the completed commands keep their response and the next
+ *         command of each idle device is started. It is called by kit_protocol_task.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_device_schedule(void);
+
+/** \brief This function polls the completion of a device:talk_async command.
+ *
+ *  \param[in]    device_id              reference to the selected device address (the ticket
+ *                                       tells the device of the command)
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] message                As input, the ticket of the command
+ *                                       As output, the response of the command once completed
+ *                length                 As input, references to size of message (number of bytes)
+ *                                       As output, references to size of the response
+ *
+ *  \return KIT_STATUS_PENDING while the device executes the command, KIT_STATUS_INVALID_ID
+ *          for an unknown ticket, otherwise the status of the command
+ */
+enum kit_protocol_status kit_device_poll(uint32_t device_id, uint8_t * message, uint16_t * length);
+
+/** \brief This function gives up a device:talk_async command: a queued command is
+ *         dropped, the response of a running one is dropped once read, and the
+ *         ticket is free for another command.
+ *
+ *  \note  With KIT_HAL_TIMER, a response not polled within KIT_ASYNC_EXPIRY_MS is
+ *         dropped as well.
+ *
+ *  \param[in]    device_id              reference to the selected device address (the ticket
+ *                                       tells the device of the command)
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] message                As input, the ticket of the command
+ *                                       As output, None
+ *                length                 As input, references to size of message (number of bytes)
+ *                                       As output, 0
+ *
+ *  \return KIT_STATUS_SUCCESS on success, KIT_STATUS_INVALID_ID for an unknown ticket
+ */
+enum kit_protocol_status kit_device_cancel(uint32_t device_id, uint8_t * message, uint16_t * length);
+
+/** \brief This function wakes the device, sends a talk command and ends with an
+ *         idle or sleep token, in a single message.
+ *
+ *  \param[in]    device_id              reference to device address
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] message                As input, <token><command packet> where the token is
+ *                                       00 (none), 01 (idle) or 02 (sleep)
+ *                                       As output, <wake status><talk status><token status>
+ *                                       followed by the talk response
+ *                length                 As input, references to size of message (number of bytes)
+ *                                       As output, references to size of the response
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise the status of the first failed step
+ */
+enum kit_protocol_status kit_device_transact(uint32_t device_id, uint8_t * message, uint16_t * length);
+
 /** \brief This function writes to memory
  *
  *  \param[in]    device_id              reference to device address
@@ -235,18 +353,6 @@ enum kit_protocol_status kit_device_mem_write(uint32_t device_id, uint8_t * mess
  */
 enum kit_protocol_status kit_device_mem_read(uint32_t device_id, uint8_t * message, uint16_t * length);
 
-/** \brief The function prints the string (debug message) in output console
- *
- *  \param[in]    str                   references to string (debug message)
- *
- *  \param[out]   None
- *
- *  \param[inout] None
- *
- *  \return None
- */
-void print_kit_traffic(const char *str);
-
 /** \brief The function receives and send message to device via USB interface
  *
  *  \param[in]    params
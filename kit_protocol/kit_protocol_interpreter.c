@@ -30,29 +30,307 @@
  * TERMS.
  */
 
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "kit_protocol_interpreter.h"
+#include "kit_protocol_hex_codec.h"
 #include "kit_protocol_utilities.h"
 #include "kit_hal_interface.h"
 
-static struct kit_interpreter_interface *g_kit_interpreter_interface = NULL;
-static enum kit_protocol_command g_message_command = KIT_COMMAND_UNKNOWN;
-static char g_message_data[KIT_MESSAGE_SIZE_MAX];
-char g_section[KIT_SECTION_NAME_SIZE_MAX];
-static uint16_t g_message_length = 0;
-static uint32_t g_selected_device_handle = 0;
+static struct kit_interpreter_ctx g_kit_interpreter_ctx;
 device_type_t g_selected_device_type = DEVICE_TYPE_UNKNOWN;
-interface_id_t g_selected_interface_type = DEVKIT_IF_UNKNOWN;
 
 const char *interface_string[] = { "no_device ", "SPI ", "TWI ", "SWI ", "SWI " };
 
+#if (MAX_DISCOVER_DEVICES > 32)
+#error MAX_DISCOVER_DEVICES does not fit in the fan-out target mask
+#endif
+
+#define KIT_FANOUT_ENTRY_HEADER_SIZE  (4)    // <device index><status><length:2> ahead of each fan-out response
+#define KIT_FANOUT_RESPONSE_MAX       (256)  // The room kept for each fan-out device response
+
+#ifndef KIT_FANOUT_POLL_US
+#define KIT_FANOUT_POLL_US            (250)  //! The fan-out talk response poll interval
+#endif // KIT_FANOUT_POLL_US
+
+#ifndef KIT_FANOUT_TIMEOUT_MS
+#define KIT_FANOUT_TIMEOUT_MS         (2000) //! The longest wait for a fan-out talk response, then it times out
+#endif // KIT_FANOUT_TIMEOUT_MS
+
+#define KIT_COMMAND_LETTERS      (27)    // Command word letters 'a' to 'z' and '_'
+#define KIT_COMMAND_UNDERSCORE   (26)    // The letter entry of '_' (Ex. talk_async)
+#define KIT_COMMAND_NEXT_LETTER  (0x80)  // The command word is resolved by the next letter node
+
+/**
+ * \brief A command word trie node.
+ *
+ * A letter entry holds either a command slot, or KIT_COMMAND_NEXT_LETTER with
+ * the index of the node resolving the next letter. Letters without an entry
+ * (and the end of the word) resolve to the node default. The letters after the
+ * resolving one are not checked, so the full command words and their
+ * abbreviations are both accepted (Ex. device:talk(...) and d:t(...)).
+ */
+struct kit_command_node
+{
+    uint8_t other;                          // The slot of the letters without an entry
+    uint8_t letter[KIT_COMMAND_LETTERS];    // The slot or next node of each letter
+};
+
+enum kit_command_node_index
+{
+    KIT_NODE_BOARD,                         // board:<command>
+    KIT_NODE_DEVICE,                        // device:<command>
+    KIT_NODE_BOARD_D,                       // board:d...
+    KIT_NODE_DEVICE_S,                      // device:s...
+    KIT_NODE_DEVICE_M,                      // device:m...
+    KIT_NODE_DEVICE_P,                      // device:p...
+    KIT_NODE_DEVICE_T,                      // device:t...
+    KIT_NODE_DEVICE_TA,                     // device:ta...
+    KIT_NODE_DEVICE_TAL,                    // device:tal...
+    KIT_NODE_DEVICE_TALK                    // device:talk...
+};
+
+static const struct kit_command_node g_kit_command_nodes[] =
+{
+    [KIT_NODE_BOARD] = {
+        .other = KIT_SLOT_NONE,
+        .letter = {
+            ['a' - 'a'] = KIT_SLOT_BOARD_APPLICATION,                 // application
+            ['b' - 'a'] = KIT_SLOT_BOARD_BINARY,                      // binary
+            ['d' - 'a'] = KIT_COMMAND_NEXT_LETTER | KIT_NODE_BOARD_D, // device, discover
+            ['f' - 'a'] = KIT_SLOT_BOARD_FIRMWARE,                    // firmware
+            ['g' - 'a'] = KIT_SLOT_BOARD_GET_DEVICES,                 // get_devices
+            ['l' - 'a'] = KIT_SLOT_BOARD_GET_LAST_ERROR,              // last_error
+            ['p' - 'a'] = KIT_SLOT_BOARD_PROFILE,                     // profile
+            ['s' - 'a'] = KIT_SLOT_BOARD_SCRIPT,                      // script
+            ['t' - 'a'] = KIT_SLOT_BOARD_TIMING,                      // timing
+            ['v' - 'a'] = KIT_SLOT_BOARD_VERSION,                     // version
+        },
+    },
+    [KIT_NODE_DEVICE] = {
+        .other = KIT_SLOT_NONE,
+        .letter = {
+            ['c' - 'a'] = KIT_SLOT_DEVICE_CANCEL,                     // cancel
+            ['i' - 'a'] = KIT_SLOT_DEVICE_IDLE,                       // idle
+            ['m' - 'a'] = KIT_COMMAND_NEXT_LETTER | KIT_NODE_DEVICE_M,// mw, mr
+            ['p' - 'a'] = KIT_COMMAND_NEXT_LETTER | KIT_NODE_DEVICE_P,// physical, poll
+            ['r' - 'a'] = KIT_SLOT_DEVICE_RECEIVE,                    // receive
+            ['s' - 'a'] = KIT_COMMAND_NEXT_LETTER | KIT_NODE_DEVICE_S,// sleep, send
+            ['t' - 'a'] = KIT_COMMAND_NEXT_LETTER | KIT_NODE_DEVICE_T,// talk, transact
+            ['w' - 'a'] = KIT_SLOT_DEVICE_WAKE,                       // wake
+        },
+    },
+    [KIT_NODE_BOARD_D] = {
+        .other = KIT_SLOT_BOARD_GET_DEVICE,                           // device
+        .letter = {
+            ['i' - 'a'] = KIT_SLOT_BOARD_DISCOVER,                    // discover
+        },
+    },
+    [KIT_NODE_DEVICE_S] = {
+        .other = KIT_SLOT_DEVICE_SLEEP,                               // sleep
+        .letter = {
+            ['e' - 'a'] = KIT_SLOT_DEVICE_SEND,                       // send
+        },
+    },
+    [KIT_NODE_DEVICE_M] = {
+        .other = KIT_SLOT_NONE,
+        .letter = {
+            ['r' - 'a'] = KIT_SLOT_MEMORY_READ,                       // mr
+            ['w' - 'a'] = KIT_SLOT_MEMORY_WRITE,                      // mw
+        },
+    },
+    [KIT_NODE_DEVICE_P] = {
+        .other = KIT_SLOT_PHYSICAL,                                   // physical
+        .letter = {
+            ['o' - 'a'] = KIT_SLOT_DEVICE_POLL,                       // poll
+        },
+    },
+    [KIT_NODE_DEVICE_T] = {
+        .other = KIT_SLOT_DEVICE_TALK,                                // talk
+        .letter = {
+            ['a' - 'a'] = KIT_COMMAND_NEXT_LETTER | KIT_NODE_DEVICE_TA,
+            ['r' - 'a'] = KIT_SLOT_DEVICE_TRANSACT,                   // transact
+        },
+    },
+    [KIT_NODE_DEVICE_TA] = {
+        .other = KIT_SLOT_DEVICE_TALK,                                // talk
+        .letter = {
+            ['l' - 'a'] = KIT_COMMAND_NEXT_LETTER | KIT_NODE_DEVICE_TAL,
+        },
+    },
+    [KIT_NODE_DEVICE_TAL] = {
+        .other = KIT_SLOT_DEVICE_TALK,                                // talk
+        .letter = {
+            ['k' - 'a'] = KIT_COMMAND_NEXT_LETTER | KIT_NODE_DEVICE_TALK,
+        },
+    },
+    [KIT_NODE_DEVICE_TALK] = {
+        .other = KIT_SLOT_DEVICE_TALK,                                // talk
+        .letter = {
+            [KIT_COMMAND_UNDERSCORE] = KIT_SLOT_DEVICE_TALK_ASYNC,    // talk_async
+        },
+    },
+};
+
+// The Kit Protocol command of each command handler slot
+static const enum kit_protocol_command g_kit_slot_command[KIT_SLOT_COUNT] =
+{
+    [KIT_SLOT_NONE]                 = KIT_COMMAND_UNKNOWN,
+    [KIT_SLOT_BOARD_VERSION]        = KIT_COMMAND_BOARD_VERSION,
+    [KIT_SLOT_BOARD_FIRMWARE]       = KIT_COMMAND_BOARD_FIRMWARE,
+    [KIT_SLOT_BOARD_GET_DEVICE]     = KIT_COMMAND_BOARD_GET_DEVICE,
+    [KIT_SLOT_BOARD_GET_DEVICES]    = KIT_COMMAND_BOARD_GET_DEVICES,
+    [KIT_SLOT_BOARD_DISCOVER]       = KIT_COMMAND_BOARD_DISCOVER,
+    [KIT_SLOT_BOARD_GET_LAST_ERROR] = KIT_COMMAND_BOARD_GET_LAST_ERROR,
+    [KIT_SLOT_BOARD_APPLICATION]    = KIT_COMMAND_BOARD_APPLICATION,
+    [KIT_SLOT_BOARD_POLLING]        = KIT_COMMAND_BOARD_POLLING,
+    [KIT_SLOT_BOARD_BINARY]         = KIT_COMMAND_BOARD_BINARY,
+    [KIT_SLOT_BOARD_TIMING]         = KIT_COMMAND_BOARD_TIMING,
+    [KIT_SLOT_BOARD_SCRIPT]         = KIT_COMMAND_BOARD_SCRIPT,
+    [KIT_SLOT_BOARD_PROFILE]        = KIT_COMMAND_BOARD_PROFILE,
+    [KIT_SLOT_DEVICE_IDLE]          = KIT_COMMAND_DEVICE_IDLE,
+    [KIT_SLOT_DEVICE_SLEEP]         = KIT_COMMAND_DEVICE_SLEEP,
+    [KIT_SLOT_DEVICE_WAKE]          = KIT_COMMAND_DEVICE_WAKE,
+    [KIT_SLOT_DEVICE_SEND]          = KIT_COMMAND_DEVICE_SEND,
+    [KIT_SLOT_DEVICE_RECEIVE]       = KIT_COMMAND_DEVICE_RECEIVE,
+    [KIT_SLOT_DEVICE_TALK]          = KIT_COMMAND_DEVICE_TALK,
+    [KIT_SLOT_MEMORY_WRITE]         = KIT_COMMAND_MEMORY_WRITE,
+    [KIT_SLOT_MEMORY_READ]          = KIT_COMMAND_MEMORY_READ,
+    [KIT_SLOT_DEVICE_TRANSACT]      = KIT_COMMAND_DEVICE_TRANSACT,
+    [KIT_SLOT_DEVICE_TALK_ASYNC]    = KIT_COMMAND_DEVICE_TALK_ASYNC,
+    [KIT_SLOT_DEVICE_POLL]          = KIT_COMMAND_DEVICE_POLL,
+    [KIT_SLOT_DEVICE_CANCEL]        = KIT_COMMAND_DEVICE_CANCEL,
+    [KIT_SLOT_PHYSICAL]             = KIT_COMMAND_PHYSICAL,
+    [KIT_SLOT_PHYSICAL_SELECT]      = KIT_COMMAND_PHYSICAL_SELECT,
+};
+
+/** \brief Sets the command of the current message.
+ *
+ *  \param[in]    slot                 The command handler slot
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                  The interpreter context
+ *
+ *  \return None
+ */
+static void kit_interpreter_set_command(struct kit_interpreter_ctx *ctx, enum kit_command_slot slot)
+{
+    ctx->message_slot = slot;
+    ctx->message_command = g_kit_slot_command[slot];
+}
+
+
+/** \brief Returns a lowercase character of a message section.
+ *
+ *  \param[in]    message              The command message
+ *                section              The message section
+ *                index                The index of the character within the section
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The lowercase character, or '\0' when the index is outside the section
+ */
+static char kit_interpreter_section_char(const char *message, const struct kit_message_span *section, uint16_t index)
+{
+    return (index < section->length) ? (char)tolower((uint8_t)message[section->offset + index]) : '\0';
+}
+
+/** \brief Converts an ASCII hex message section to a value.
+ *
+ *  \param[in]    message              The command message
+ *                section              The message section containing the ASCII hex value
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The value
+ */
+static uint32_t kit_interpreter_section_value(const char *message, const struct kit_message_span *section)
+{
+    uint32_t value = 0;
+
+    for (uint16_t index = 0; index < section->length; index++)
+    {
+        value = (value << 4) | kit_protocol_convert_hex_to_nibble((uint8_t)message[section->offset + index]);
+    }
+
+    return value;
+}
+
+/** \brief Parses the target list of a device(<index>,<index>,...) or a device(*) message.
+ *
+ *  \param[in]    message              The command message
+ *                handle               The handle section of the command message
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                  The interpreter context
+ *
+ *  \return KIT_STATUS_SUCCESS on success, KIT_STATUS_NO_DEVICE when a device index was not
+ *          discovered, otherwise KIT_STATUS_COMMAND_NOT_VALID
+ */
+static enum kit_protocol_status kit_interpreter_parse_fanout(struct kit_interpreter_ctx *ctx, const char *message,
+                                                             const struct kit_message_span *handle)
+{
+    const char *list = &message[handle->offset];
+    const device_info_t *device;
+    uint32_t targets = 0;
+    uint16_t index;
+    uint8_t device_index;
+
+    if ((handle->length == 1) && (list[0] == KIT_FANOUT_ALL))
+    {
+        for (device_index = 0; (device = get_device_info(device_index)) != NULL; device_index++)
+        {
+            if (device->bus_type != DEVKIT_IF_UNKNOWN)
+            {
+                targets |= (1UL << device_index);
+            }
+        }
+    }
+    else if (((handle->length + 1) % (KIT_DEVICE_INDEX_SIZE + 1)) != 0)
+    {
+        // Invalid Kit Protocol command message format
+        return KIT_STATUS_COMMAND_NOT_VALID;
+    }
+    else
+    {
+        for (index = 0; index < handle->length; index += (KIT_DEVICE_INDEX_SIZE + 1))
+        {
+            if (!isxdigit((uint8_t)list[index]) ||
+                !isxdigit((uint8_t)list[index + 1]) ||
+                (((index + KIT_DEVICE_INDEX_SIZE) < handle->length) && (list[index + KIT_DEVICE_INDEX_SIZE] != KIT_FANOUT_SEPARATOR)))
+            {
+                // Invalid Kit Protocol command message format
+                return KIT_STATUS_COMMAND_NOT_VALID;
+            }
+
+            device_index = (uint8_t)((kit_protocol_convert_hex_to_nibble((uint8_t)list[index]) << 4) |
+                                     kit_protocol_convert_hex_to_nibble((uint8_t)list[index + 1]));
+            device = get_device_info(device_index);
+            if ((device == NULL) || (device->bus_type == DEVKIT_IF_UNKNOWN))
+            {
+                return KIT_STATUS_NO_DEVICE;
+            }
+            targets |= (1UL << device_index);
+        }
+    }
+
+    ctx->fanout_targets = targets;
+
+    return (targets != 0) ? KIT_STATUS_SUCCESS : KIT_STATUS_NO_DEVICE;
+}
 
 /** \brief Parses the target (<target>) section of the Kit Protocol message.
  *
- *  \param[in]    section              The target section name to be parsed
- *                section_length       The length, in bytes, of the target section name
+ *  \param[in]    message              The command message
+ *                tokens               The sections of the command message
  *
  *  \param[out]   None
  *
@@ -60,22 +338,15 @@ const char *interface_string[] = { "no_device ", "SPI ", "TWI ", "SWI ", "SWI "
  *
  *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
  */
-static enum kit_protocol_status kit_interpreter_parse_target_section(char *section, uint16_t section_length)
+static enum kit_protocol_status kit_interpreter_parse_target_section(struct kit_interpreter_ctx *ctx, const char *message, const struct kit_message_tokens *tokens)
 {
     enum kit_protocol_status status = KIT_STATUS_SUCCESS;
-    char *begin_delimiter = NULL;
-    char *end_delimiter = NULL;
-    uint16_t device_handle_size = 0;
-    uint32_t device_handle = 0;
-
-    // Convert the Kit Protocol command message to lowercase
-    kit_protocol_convert_to_lowercase(section_length, section);
 
     // Check the first character in target section
-    switch (section[0])
+    switch (kit_interpreter_section_char(message, &tokens->target, 0))
     {
     case 'b':        // The target: board
-        g_message_command = KIT_COMMAND_BOARD;
+        ctx->message_command = KIT_COMMAND_BOARD;
         break;
 
 #ifndef KIT_PROTOCOL_NO_LEGACY_SUPPORT
@@ -85,35 +356,33 @@ static enum kit_protocol_status kit_interpreter_parse_target_section(char *secti
     case 't':        // The target: TA100
 #endif // KIT_PROTOCOL_NO_LEGACY_SUPPORT
     case 'd':        // The target: device
-        g_message_command = KIT_COMMAND_DEVICE;
+        ctx->message_command = KIT_COMMAND_DEVICE;
         break;
 
     default:
         // Unknown Kit Protocol command message
-        g_message_command = KIT_COMMAND_UNKNOWN;
+        kit_interpreter_set_command(ctx, KIT_SLOT_NONE);
     }
 
+    ctx->fanout_targets = 0;
+
     // Find the device index
-    if (g_message_command != KIT_COMMAND_UNKNOWN)
+    if (ctx->message_command != KIT_COMMAND_UNKNOWN)
     {
-        begin_delimiter = strchr(section, KIT_DATA_BEGIN_DELIMITER);
-        if (begin_delimiter != NULL)
+        if (tokens->handle.offset != 0)
         {
-            end_delimiter = strchr(section, KIT_DATA_END_DELIMITER);
-            if (end_delimiter == NULL)
+            if ((ctx->message_command == KIT_COMMAND_DEVICE) &&
+                ((memchr(&message[tokens->handle.offset], KIT_FANOUT_SEPARATOR, tokens->handle.length) != NULL) ||
+                 (tokens->handle.length == KIT_DEVICE_INDEX_SIZE) ||
+                 ((tokens->handle.length == 1) && (message[tokens->handle.offset] == KIT_FANOUT_ALL))))
             {
-                end_delimiter = (begin_delimiter + KIT_DEVICE_HANDLE_SIZE);
+                // Run the command on each device of the target list
+                status = kit_interpreter_parse_fanout(ctx, message, &tokens->handle);
             }
-
-            // Get the device handle size
-            device_handle_size = (end_delimiter - (begin_delimiter + 1));
-            if (device_handle_size == KIT_DEVICE_HANDLE_SIZE)
+            else if (tokens->handle.length == KIT_DEVICE_HANDLE_SIZE)
             {
-                // Retrieve the device handle from the section string data
-                device_handle = (uint32_t)strtol((begin_delimiter + 1), NULL, 16);
-
                 // Set the currently selected device handle
-                kit_interpreter_set_selected_device_handle(device_handle);
+                kit_interpreter_set_selected_device_handle_ctx(ctx, kit_interpreter_section_value(message, &tokens->handle));
             }
             else
             {
@@ -133,8 +402,8 @@ static enum kit_protocol_status kit_interpreter_parse_target_section(char *secti
 
 /** \brief Parses the command (<command>) section of the Kit Protocol message.
  *
- *  \param[in]    section               The command section name to be parsed
- *                section_length        The length, in bytes, of the command section name
+ *  \param[in]    message              The command message
+ *                tokens               The sections of the command message
  *
  *  \param[out]   None
  *
@@ -142,170 +411,86 @@ static enum kit_protocol_status kit_interpreter_parse_target_section(char *secti
  *
  *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
  */
-static enum kit_protocol_status kit_interpreter_parse_command_section(char *section, uint16_t section_length)
+static enum kit_protocol_status kit_interpreter_parse_command_section(struct kit_interpreter_ctx *ctx, const char *message, const struct kit_message_tokens *tokens)
 {
     enum kit_protocol_status status = KIT_STATUS_SUCCESS;
-    char *begin_delimiter = NULL;
-    char *end_delimiter = NULL;
-
-    // Find the data delimiter
-    begin_delimiter = strchr(section, KIT_DATA_BEGIN_DELIMITER);
-    if (begin_delimiter == NULL)
-    {
-        begin_delimiter = strchr(section, KIT_LAYER_DELIMITER);
-    }
+    const struct kit_command_node *node;
+    uint8_t entry = KIT_SLOT_NONE;
+    uint16_t index = 0;
+    char letter;
 
-    if (begin_delimiter != NULL)
+    if ((ctx->message_command == KIT_COMMAND_BOARD) || (ctx->message_command == KIT_COMMAND_DEVICE))
     {
-        // Convert the Kit Protocol command message to lowercase
-        kit_protocol_convert_to_lowercase((begin_delimiter - section), section);
-
-        if (g_message_command == KIT_COMMAND_BOARD)
+        // Walk the command word trie of the target, one node per letter
+        node = &g_kit_command_nodes[(ctx->message_command == KIT_COMMAND_BOARD) ? KIT_NODE_BOARD : KIT_NODE_DEVICE];
+        while (1)
         {
-            // Board messages
-
-            // Check the first character in board command section
-            switch (section[0])
+            letter = kit_interpreter_section_char(message, &tokens->command, index++);
+            if ((letter >= 'a') && (letter <= 'z'))
             {
-            case 'v':        // The board version command: board:version()
-                g_message_command = KIT_COMMAND_BOARD_VERSION;
-                break;
-
-            case 'f':        // The board firmware command: board:firmware()
-                g_message_command = KIT_COMMAND_BOARD_FIRMWARE;
-                break;
-
-            case 'd':
-                // Check the second character in board command section
-                switch (section[1])
-                {
-                case 'i':    // The board discovery command: board:discover()
-                    g_message_command = KIT_COMMAND_BOARD_DISCOVER;
-                    break;
-
-                default:     // The board get device command: board:device(00)
-                    g_message_command = KIT_COMMAND_BOARD_GET_DEVICE;
-                    break;
-                }
-                break;
-
-            case 'g':        // The board get devices command: board:get_devices()
-                g_message_command = KIT_COMMAND_BOARD_GET_DEVICES;
-                break;
-
-            case 'l':        // The board get last error command: board:last_error()
-                g_message_command = KIT_COMMAND_BOARD_GET_LAST_ERROR;
-                break;
-
-            case 'a':        // The board application-specific command: board:application(...)
-                g_message_command = KIT_COMMAND_BOARD_APPLICATION;
-                break;
-
-            default:
-                // Unknown Kit Protocol command message
-                g_message_command = KIT_COMMAND_UNKNOWN;
+                entry = node->letter[letter - 'a'];
             }
-        }
-        else if (g_message_command == KIT_COMMAND_DEVICE)
-        {
-            // Board messages
-
-            // Check the first character in board command section
-            switch (section[0])
+            else
             {
-            case 'p':        // The device physical command: device[(00)]:physical:...
-                g_message_command = KIT_COMMAND_PHYSICAL;
-                break;
-
-            case 'i':        // The device idle command: device[(00)]:idle()
-                g_message_command = KIT_COMMAND_DEVICE_IDLE;
-                break;
-
-            case 's':
-                // Check the second character in command section
-                switch (section[1])
-                {
-                case 'e':    // The device send command: device[(00)]:send(...)
-                    g_message_command = KIT_COMMAND_DEVICE_SEND;
-                    break;
-
-                default:     // The device sleep command: device[(00)]:sleep()
-                    g_message_command = KIT_COMMAND_DEVICE_SLEEP;
-                    break;
-                }
-                break;
-
-            case 'm':
-                // Check the second character in command section
-                switch (section[1])
-                {
-                case 'w':    // The device send command: device[(00)]:send(...)
-                    g_message_command = KIT_COMMAND_MEMORY_WRITE;
-                    break;
-                case 'r':     // The device sleep command: device[(00)]:sleep()
-                    g_message_command = KIT_COMMAND_MEMORY_READ;
-                    break;
-                default:
-                    g_message_command = KIT_COMMAND_UNKNOWN;
-                    break;
-                }
-                break;
-
-            case 'w':        // The device wakeup command: device[(00)]:wake()
-                g_message_command = KIT_COMMAND_DEVICE_WAKE;
-                break;
-
-            case 'r':        // The device receive command: device[(00)]:receive()
-                g_message_command = KIT_COMMAND_DEVICE_RECEIVE;
-                break;
-
-            case 't':        // The device talk command: device[(00)]:talk(...)
-                g_message_command = KIT_COMMAND_DEVICE_TALK;
-                break;
-
-            default:
-                // Unknown Kit Protocol command message
-                g_message_command = KIT_COMMAND_UNKNOWN;
+                entry = (letter == '_') ? node->letter[KIT_COMMAND_UNDERSCORE] : KIT_SLOT_NONE;
             }
-        }
-
-        // Get the message data
-        if ((g_message_command != KIT_COMMAND_PHYSICAL) &&
-            (g_message_command != KIT_COMMAND_UNKNOWN))
-        {
-            end_delimiter = strchr((begin_delimiter + 1), KIT_DATA_END_DELIMITER);
-            if (end_delimiter != NULL)
+            if (entry == KIT_SLOT_NONE)
             {
-                // Save the message data
-                memset(&g_message_data[0], 0, sizeof(g_message_data));
-                g_message_length = (end_delimiter - (begin_delimiter + 1));
-                strncpy(&g_message_data[0], (begin_delimiter + 1), g_message_length);
+                entry = node->other;
             }
-            else
+
+            if ((entry & KIT_COMMAND_NEXT_LETTER) == 0)
             {
-                // Invalid Kit Protocol command message format
-                status = KIT_STATUS_COMMAND_NOT_VALID;
+                break;
             }
+            node = &g_kit_command_nodes[entry & ~KIT_COMMAND_NEXT_LETTER];
         }
-        else if (g_message_command == KIT_COMMAND_UNKNOWN)
+    }
+
+    kit_interpreter_set_command(ctx, (enum kit_command_slot)entry);
+
+    if (ctx->message_command == KIT_COMMAND_PHYSICAL)
+    {
+        // The physical command requires a subcommand
+        if (tokens->subcommand.length == 0)
         {
             // Invalid Kit Protocol command message format
             status = KIT_STATUS_COMMAND_NOT_VALID;
         }
     }
-    else
+    else if ((ctx->message_command == KIT_COMMAND_UNKNOWN) ||
+             (tokens->subcommand.offset != 0) || (tokens->has_data == false))
     {
         // Invalid Kit Protocol command message format
         status = KIT_STATUS_COMMAND_NOT_VALID;
     }
 
+    if ((status == KIT_STATUS_SUCCESS) && (ctx->fanout_targets != 0))
+    {
+        switch (ctx->message_command)
+        {
+        case KIT_COMMAND_DEVICE_IDLE:
+        case KIT_COMMAND_DEVICE_SLEEP:
+        case KIT_COMMAND_DEVICE_WAKE:
+        case KIT_COMMAND_DEVICE_SEND:
+        case KIT_COMMAND_DEVICE_RECEIVE:
+        case KIT_COMMAND_DEVICE_TALK:
+        case KIT_COMMAND_DEVICE_TRANSACT:
+            break;
+        default:
+            // The command does not run on a target list
+            status = KIT_STATUS_COMMAND_NOT_VALID;
+            break;
+        }
+    }
+
     return status;
 }
 
 /** \brief Parses the subcommand (<subcommand>) section of the Kit Protocol message.
  *
- *  \param[in]    section               The command section name to be parsed
- *                section_length        The length, in bytes, of the command section name
+ *  \param[in]    message              The command message
+ *                tokens               The sections of the command message
  *
  *  \param[out]   None
  *
@@ -313,264 +498,334 @@ static enum kit_protocol_status kit_interpreter_parse_command_section(char *sect
  *
  *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
  */
-static enum kit_protocol_status kit_interpreter_parse_subcommand_section(char *section, uint16_t section_length)
+static enum kit_protocol_status kit_interpreter_parse_subcommand_section(struct kit_interpreter_ctx *ctx, const char *message, const struct kit_message_tokens *tokens)
 {
     enum kit_protocol_status status = KIT_STATUS_SUCCESS;
-    char *begin_delimiter = NULL;
-    char *kit_delimiter = NULL;
-    char *end_delimiter = NULL;
-    uint8_t device_index_size = 0;
-    uint8_t device_index = 0;
-
-    // Find the data delimiter
-    begin_delimiter = strchr(section, KIT_DATA_BEGIN_DELIMITER);
-    kit_delimiter = strchr(section, KIT_LAYER_DELIMITER);
-
-    if( begin_delimiter != NULL )
-    {
-        // Convert the Kit Protocol subcommand message to lowercase
-        kit_protocol_convert_to_lowercase((begin_delimiter - section), section);
-    }
+    struct kit_message_span interface_name;
+    uint16_t index = 0;
 
-    if (begin_delimiter != NULL || kit_delimiter != NULL)
+    // Check the first character in subcommand section
+    switch (kit_interpreter_section_char(message, &tokens->subcommand, 0))
     {
+    case 's':        // The device select command: device:physical:select(00)
+        kit_interpreter_set_command(ctx, KIT_SLOT_PHYSICAL_SELECT);
 
-        // Check the first character in subcommand section
-        switch (section[0])
+        if (tokens->has_data && (tokens->data.length == KIT_DEVICE_INDEX_SIZE))
         {
-        case 's':        // The device idle command: device:physical:select(00)
-            g_message_command = KIT_COMMAND_PHYSICAL_SELECT;
-            break;
-
-        case 'i':        // "i[nt]:{i[2c] | s[wi] | s[pi]}
-            section = strchr(section, KIT_LAYER_DELIMITER);
-			if (section)
-            {
-				// Set and enable interface (I2C or SWI or SPI).
-				if (section[1] == 's')
-                {
-                    if(section[2] == 'p')
-                    {
-                        g_selected_interface_type = DEVKIT_IF_SPI;
-                    }
-
-                    if(section[2] == 'w')
-                    {
-                        if(section[4] != '\0')
-                        {
-                            g_selected_interface_type = DEVKIT_IF_SWI2;
-                        }
-                        else
-                        {
-                            g_selected_interface_type = DEVKIT_IF_SWI;
-                        }
-                    }
-                }
-                else
-                {
-                    g_selected_interface_type = DEVKIT_IF_I2C;
-                }
-            }		
+            // Set the currently selected device handle from the converted data
+            kit_interpreter_set_selected_device_handle_ctx(ctx, (uint8_t)ctx->message_data[0]);
+        }
+        else
+        {
+            // Invalid Kit Protocol command message format
+            status = KIT_STATUS_COMMAND_NOT_VALID;
+        }
+        break;
 
-        default:
-            // Unknown Kit Protocol command message
-            g_message_command = KIT_COMMAND_UNKNOWN;
+    case 'i':        // "i[nt]:{i[2c] | s[wi] | s[pi]}
+        // Locate the interface name after the layer delimiter
+        while ((index < tokens->subcommand.length) &&
+               (message[tokens->subcommand.offset + index] != KIT_LAYER_DELIMITER))
+        {
+            index++;
         }
 
-        // Parse the message data
-        if (g_message_command == KIT_COMMAND_PHYSICAL_SELECT)
+        if (index < tokens->subcommand.length)
         {
-            end_delimiter = strchr((begin_delimiter + 1), KIT_DATA_END_DELIMITER);
-            if (end_delimiter != NULL)
+            interface_name.offset = tokens->subcommand.offset + index + 1;
+            interface_name.length = tokens->subcommand.length - index - 1;
+
+            // Set and enable interface (I2C or SWI or SPI).
+            if (kit_interpreter_section_char(message, &interface_name, 0) == 's')
             {
-                // Determine the device index size
-                device_index_size = (end_delimiter - (begin_delimiter + 1));
-                if (device_index_size == KIT_DEVICE_INDEX_SIZE)
+                if (kit_interpreter_section_char(message, &interface_name, 1) == 'p')
                 {
-                    // Retrieve the device handle from the section string data
-                    device_index = (uint8_t)strtol((begin_delimiter + 1), NULL, 16);
-
-                    // Set the currently selected device handle
-                    kit_interpreter_set_selected_device_handle(device_index);
+                    ctx->selected_interface_type = DEVKIT_IF_SPI;
                 }
-                else
+
+                if (kit_interpreter_section_char(message, &interface_name, 1) == 'w')
                 {
-                    // Invalid Kit Protocol command message format
-                    status = KIT_STATUS_COMMAND_NOT_VALID;
+                    if (interface_name.length > 3)
+                    {
+                        ctx->selected_interface_type = DEVKIT_IF_SWI2;
+                    }
+                    else
+                    {
+                        ctx->selected_interface_type = DEVKIT_IF_SWI;
+                    }
                 }
             }
             else
             {
-                // Invalid Kit Protocol command message format
-                status = KIT_STATUS_COMMAND_NOT_VALID;
+                ctx->selected_interface_type = DEVKIT_IF_I2C;
             }
         }
-    }
-    else
-    {
-        // Invalid Kit Protocol command message format
+
+        // The interface is used by the following select command, nothing to respond
+        kit_interpreter_set_command(ctx, KIT_SLOT_NONE);
+        ctx->message_length = 0;
+        break;
+
+    default:
+        // Unknown Kit Protocol command message
+        kit_interpreter_set_command(ctx, KIT_SLOT_NONE);
         status = KIT_STATUS_COMMAND_NOT_VALID;
     }
 
     return status;
 }
 
-/** \brief Parses the incoming Kit Protocol command message.
+/** \brief Advances the Kit Protocol message tokenizer by one character.
  *
- *  \param[in]    message                The command message to be parsed
- *                message_length         The length, in bytes, of the command message
+ *  \param[in]    character            The message character (not the message delimiter)
+ *                index                The index of the character in the message
  *
  *  \param[out]   None
  *
- *  \param[inout] None
+ *  \param[inout] state                The tokenizer state
+ *                tokens               The sections of the command message
  *
- *  \return KIT_STATUS_SUCCESS on success otherwise error code
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
  */
-static enum kit_protocol_status kit_interpreter_parse(const char *message, uint16_t message_length)
+static enum kit_protocol_status kit_interpreter_tokenize_char(enum kit_tokenizer_state *state, struct kit_message_tokens *tokens,
+                                                              char character, uint16_t index)
 {
-    enum kit_protocol_status status = KIT_STATUS_SUCCESS;
-    char *current_delimiter_location = NULL;
-    char *previous_delimiter_location = NULL;
-    size_t target_length = 0;
-    size_t command_length = 0;
-
-    // Parse the Kit Protocol target information
-    previous_delimiter_location = (char*)message;
-
-    // Find the target delimiter <target>:<command>:<subcommand>
-    current_delimiter_location = strchr(previous_delimiter_location, KIT_LAYER_DELIMITER);
-    if (current_delimiter_location != NULL)
+    switch (*state)
     {
-        target_length = min(KIT_SECTION_NAME_SIZE_MAX,
-                            ((current_delimiter_location - previous_delimiter_location) + 1));
-        if (target_length > 0)
+    case KIT_TOKENIZER_TARGET:
+        if (character == KIT_LAYER_DELIMITER)
         {
-            // Parse the target information
-            strncpy(g_section, previous_delimiter_location, target_length);
-            g_section[target_length] = '\0';
-            status = kit_interpreter_parse_target_section(g_section, target_length);
-            if (status != KIT_STATUS_SUCCESS)
-            {
-                // Invalid Kit Protocol command message format
-                status = KIT_STATUS_COMMAND_NOT_VALID;
-            }
+            tokens->target.length = index;
+            tokens->command.offset = (index + 1);
+            *state = KIT_TOKENIZER_COMMAND;
         }
-        else
+        else if (character == KIT_DATA_BEGIN_DELIMITER)
         {
-            // Invalid Kit Protocol command message format
-            status = KIT_STATUS_COMMAND_NOT_VALID;
+            tokens->target.length = index;
+            tokens->handle.offset = (index + 1);
+            *state = KIT_TOKENIZER_HANDLE;
         }
-    }
-    else
-    {
-        // Invalid Kit Protocol command message format
-        status = KIT_STATUS_COMMAND_NOT_VALID;
-    }
-
+        break;
 
-    // Parse the Kit Protocol command information
-    if (status == KIT_STATUS_SUCCESS)
-    {
-        previous_delimiter_location = (current_delimiter_location + 1);
+    case KIT_TOKENIZER_HANDLE:
+        if (character == KIT_DATA_END_DELIMITER)
+        {
+            tokens->handle.length = (index - tokens->handle.offset);
+            *state = KIT_TOKENIZER_TARGET_END;
+        }
+        break;
 
-        // Find the target delimiter or end of message delimiter
-        current_delimiter_location = strchr(previous_delimiter_location, KIT_LAYER_DELIMITER);
-        if (current_delimiter_location == NULL)
+    case KIT_TOKENIZER_TARGET_END:
+        if (character != KIT_LAYER_DELIMITER)
         {
-            current_delimiter_location = strchr(previous_delimiter_location, KIT_MESSAGE_DELIMITER);
+            // Invalid Kit Protocol command message format
+            return KIT_STATUS_COMMAND_NOT_VALID;
         }
+        tokens->command.offset = (index + 1);
+        *state = KIT_TOKENIZER_COMMAND;
+        break;
 
-        if (current_delimiter_location != NULL)
+    case KIT_TOKENIZER_COMMAND:
+        if (character == KIT_LAYER_DELIMITER)
         {
-            command_length = ((current_delimiter_location - previous_delimiter_location) + 1);
-            if (command_length > 0)
-            {
-                // Parse the command information
-                strncpy(g_section, previous_delimiter_location, command_length);
-                g_section[command_length] = '\0';
-                status = kit_interpreter_parse_command_section(g_section, command_length);
-                if (status != KIT_STATUS_SUCCESS)
-                {
-                    // Invalid Kit Protocol command message format
-                    status = KIT_STATUS_COMMAND_NOT_VALID;
-                }
-            }
-            else
-            {
-                // Invalid Kit Protocol command message format
-                status = KIT_STATUS_COMMAND_NOT_VALID;
-            }
+            tokens->command.length = (index - tokens->command.offset);
+            tokens->subcommand.offset = (index + 1);
+            *state = KIT_TOKENIZER_SUBCOMMAND;
         }
-        else
+        else if (character == KIT_DATA_BEGIN_DELIMITER)
         {
-            // Invalid Kit Protocol command message format
-            status = KIT_STATUS_COMMAND_NOT_VALID;
+            tokens->command.length = (index - tokens->command.offset);
+            tokens->data.offset = (index + 1);
+            *state = KIT_TOKENIZER_DATA;
         }
-    }
-
+        break;
 
-    // Parse the Kit Protocol subcommand information (Only needed for device physical messages)
-    if ((status == KIT_STATUS_SUCCESS) &&
-        (g_message_command == KIT_COMMAND_PHYSICAL))
-    {
-        previous_delimiter_location = (current_delimiter_location + 1);
+    case KIT_TOKENIZER_SUBCOMMAND:
+        if (character == KIT_DATA_BEGIN_DELIMITER)
+        {
+            tokens->subcommand.length = (index - tokens->subcommand.offset);
+            tokens->data.offset = (index + 1);
+            *state = KIT_TOKENIZER_DATA;
+        }
+        break;
 
-        // Find the end of message delimiter
-        current_delimiter_location = strchr(previous_delimiter_location, KIT_MESSAGE_DELIMITER);
-        if (current_delimiter_location != NULL)
+    case KIT_TOKENIZER_DATA:
+        if (character == KIT_DATA_END_DELIMITER)
         {
-            command_length = (current_delimiter_location - previous_delimiter_location);
-            if (command_length > 0)
-            {
-                // Parse the subcommand information
-                strncpy(g_section, previous_delimiter_location, command_length);
-                g_section[command_length] = '\0';
-                status = kit_interpreter_parse_subcommand_section(g_section, command_length);
-                if (status != KIT_STATUS_SUCCESS)
-                {
-                    // Invalid Kit Protocol command message format
-                    status = KIT_STATUS_COMMAND_NOT_VALID;
-                }
-            }
-            else
-            {
-                // Invalid Kit Protocol command message format
-                status = KIT_STATUS_COMMAND_NOT_VALID;
-            }
-        }
-        else
-        {
-            // Invalid Kit Protocol command message format
-            status = KIT_STATUS_COMMAND_NOT_VALID;
+            tokens->data.length = (index - tokens->data.offset);
+            tokens->has_data = true;
+            *state = KIT_TOKENIZER_DATA_END;
         }
+        break;
+
+    case KIT_TOKENIZER_DATA_END:
+    default:
+        // Ignore anything between the data and the message delimiter
+        break;
     }
 
+    return KIT_STATUS_SUCCESS;
+}
 
-    // Convert the ASCII hex message data to binary
-    if (status == KIT_STATUS_SUCCESS)
+/** \brief Closes the Kit Protocol message section ended by the message delimiter.
+ *
+ *  \param[in]    state                The tokenizer state
+ *                index                The index of the message delimiter in the message
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] tokens               The sections of the command message
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+static enum kit_protocol_status kit_interpreter_tokenize_end(enum kit_tokenizer_state state, struct kit_message_tokens *tokens,
+                                                             uint16_t index)
+{
+    switch (state)
     {
-        g_message_length = kit_protocol_convert_hex_to_binary(g_message_length, (uint8_t*)g_message_data);
+    case KIT_TOKENIZER_COMMAND:
+        tokens->command.length = (index - tokens->command.offset);
+        break;
+
+    case KIT_TOKENIZER_SUBCOMMAND:
+        tokens->subcommand.length = (index - tokens->subcommand.offset);
+        break;
+
+    case KIT_TOKENIZER_DATA_END:
+        break;
+
+    default:
+        // Invalid Kit Protocol command message format
+        return KIT_STATUS_COMMAND_NOT_VALID;
     }
 
-    return status;
+    tokens->message_length = (index + 1);
+
+    return KIT_STATUS_SUCCESS;
 }
 
-/** \brief Serializes the outgoing Kit Protocol response message.
+/** \brief Parses the located sections of the Kit Protocol message.
  *
- *  \param[in]    None
+ *  \note  The message data must already be converted into the context message data.
  *
- *  \param[out]   response             The response buffer to store the response message
+ *  \param[in]    message              The command message (at least up to the data section)
+ *                tokens               The sections of the command message
  *
- *  \param[inout] response_length      The length, in bytes, of the response buffer
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                  The interpreter context
  *
- *  \return KIT_STATUS_SUCCESS on success, otherwise error code
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
  */
-static enum kit_protocol_status kit_interpreter_serialize(enum kit_protocol_status status, char  *response, uint16_t *response_length)
+static enum kit_protocol_status kit_interpreter_parse_sections(struct kit_interpreter_ctx *ctx, const char *message,
+                                                               const struct kit_message_tokens *tokens)
+{
+    enum kit_protocol_status status = KIT_STATUS_SUCCESS;
+
+    // Parse the Kit Protocol target information
+    status = kit_interpreter_parse_target_section(ctx, message, tokens);
+
+    // Parse the Kit Protocol command information
+    if (status == KIT_STATUS_SUCCESS)
+    {
+        status = kit_interpreter_parse_command_section(ctx, message, tokens);
+    }
+
+    // Parse the Kit Protocol subcommand information (Only needed for device physical messages)
+    if ((status == KIT_STATUS_SUCCESS) &&
+        (ctx->message_command == KIT_COMMAND_PHYSICAL))
+    {
+        status = kit_interpreter_parse_subcommand_section(ctx, message, tokens);
+    }
+
+    return status;
+}
+
+enum kit_protocol_status kit_interpreter_tokenize(const char *message, uint16_t message_length,
+                                                  struct kit_message_tokens *tokens)
+{
+    enum kit_protocol_status status = KIT_STATUS_SUCCESS;
+    enum kit_tokenizer_state state = KIT_TOKENIZER_TARGET;
+    uint16_t index = 0;
+    char character;
+
+    if ((message == NULL) || (tokens == NULL))
+    {
+        return KIT_STATUS_INVALID_PARAM;
+    }
+
+    memset(tokens, 0, sizeof(*tokens));
+
+    for (index = 0; index < message_length; index++)
+    {
+        character = message[index];
+        if ((character == KIT_MESSAGE_DELIMITER) || (character == '\0'))
+        {
+            break;
+        }
+
+        if ((status = kit_interpreter_tokenize_char(&state, tokens, character, index)) != KIT_STATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    if ((index >= message_length) || (message[index] != KIT_MESSAGE_DELIMITER))
+    {
+        // The message delimiter was not found
+        return KIT_STATUS_COMMAND_NOT_VALID;
+    }
+
+    return kit_interpreter_tokenize_end(state, tokens, index);
+}
+
+enum kit_protocol_status kit_interpreter_parse_ctx(struct kit_interpreter_ctx *ctx, const char *message, uint16_t message_length)
+{
+    enum kit_protocol_status status = KIT_STATUS_SUCCESS;
+    struct kit_message_tokens tokens;
+    uint16_t error_offset = 0;
+
+    if ((ctx == NULL) || (message == NULL))
+    {
+        return KIT_STATUS_INVALID_PARAM;
+    }
+
+    // Locate the <target>:<command>:<subcommand>(<data>) sections
+    status = kit_interpreter_tokenize(message, message_length, &tokens);
+
+    // Convert the ASCII hex message data straight from the message to binary
+    if (status == KIT_STATUS_SUCCESS)
+    {
+        if (tokens.data.length <= (2 * (sizeof(ctx->message_data) - 1)))
+        {
+            // Reject a corrupted payload here, before it reaches the device
+            status = kit_protocol_convert_hex_to_binary_checked(tokens.data.length,
+                                                                (const uint8_t*)&message[tokens.data.offset],
+                                                                (uint8_t*)ctx->message_data, &ctx->message_length, &error_offset);
+            ctx->message_data[ctx->message_length] = '\0';
+        }
+        else
+        {
+            // The message data does not fit in the message buffer
+            status = KIT_STATUS_COMMAND_NOT_VALID;
+        }
+    }
+
+    if (status == KIT_STATUS_SUCCESS)
+    {
+        status = kit_interpreter_parse_sections(ctx, message, &tokens);
+    }
+
+    return status;
+}
+
+enum kit_protocol_status kit_interpreter_serialize_ctx(struct kit_interpreter_ctx *ctx, enum kit_protocol_status status,
+                                                       char *response, uint16_t *response_length)
 {
     if (status != KIT_STATUS_COMMAND_NOT_SUPPORTED)
     {
         // Convert the binary response message to ASCII hex data
-        switch (g_message_command)
+        switch (ctx->message_command)
         {
         case KIT_COMMAND_BOARD_VERSION:
         case KIT_COMMAND_BOARD_FIRMWARE:
@@ -580,8 +835,8 @@ static enum kit_protocol_status kit_interpreter_serialize(enum kit_protocol_stat
              * Create the Kit Protocol response message with the information from
              * the application's command handling function
              */
-            *response_length = g_message_length;
-            memcpy(&response[0], &g_message_data[0], g_message_length);
+            *response_length = ctx->message_length;
+            memcpy(&response[0], &ctx->message_data[0], ctx->message_length);
             break;
         case KIT_COMMAND_PHYSICAL_SELECT:
 
@@ -597,13 +852,17 @@ static enum kit_protocol_status kit_interpreter_serialize(enum kit_protocol_stat
 
 
         default:
-            if (g_message_length != 0)
+            if ((ctx->message_length != 0) &&
+                (kit_protocol_convert_binary_to_hex_in_place(ctx->message_length, (uint8_t*)ctx->message_data,
+                                                             sizeof(ctx->message_data), &ctx->message_length) != KIT_STATUS_SUCCESS))
+            {
+                // The ASCII hex response data does not fit in the message buffer
+                sprintf(response, "%02X()%c", (uint8_t)KIT_STATUS_SMALL_BUFFER, KIT_MESSAGE_DELIMITER);
+            }
+            else if (ctx->message_length != 0)
             {
-                // Convert the response message binary data to ASCII hex
-                g_message_length = kit_protocol_convert_binary_to_hex(g_message_length, (uint8_t*)g_message_data);
-
                 // Create the Kit Protocol response message
-                sprintf(response, "%02X(%s)%c", (uint8_t)status, g_message_data, KIT_MESSAGE_DELIMITER);
+                sprintf(response, "%02X(%s)%c", (uint8_t)status, ctx->message_data, KIT_MESSAGE_DELIMITER);
             }
             else
             {
@@ -619,33 +878,276 @@ static enum kit_protocol_status kit_interpreter_serialize(enum kit_protocol_stat
     {
         // Create the Kit Protocol KIT_STATUS_COMMAND_NOT_SUPPORTED response message
         sprintf(response, "%02X()%c", (uint8_t)status, KIT_MESSAGE_DELIMITER);
+        *response_length = strlen(response);
     }
 
     return KIT_STATUS_SUCCESS;
 }
 
-enum kit_protocol_status kit_interpreter_init(struct kit_interpreter_interface *interface)
+/** \brief The command handler of the commands not supported in this application.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                  The interpreter context
+ *
+ *  \return KIT_STATUS_COMMAND_NOT_SUPPORTED
+ */
+static enum kit_protocol_status kit_interpreter_command_not_supported(struct kit_interpreter_ctx *ctx)
+{
+    (void)ctx;
+
+    // The Kit Protocol command is not supported in this application
+    return KIT_STATUS_COMMAND_NOT_SUPPORTED;
+}
+
+// The command handler of the messages without anything to process
+static enum kit_protocol_status kit_interpreter_command_none(struct kit_interpreter_ctx *ctx)
+{
+    (void)ctx;
+
+    return KIT_STATUS_SUCCESS;
+}
+
+// The command handlers calling the application's command handling functions
+static enum kit_protocol_status kit_interpreter_board_version(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->board_get_version((uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_board_firmware(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->board_get_firmware((uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_board_get_device(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->board_get_device(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_board_get_devices(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->board_get_devices((uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_board_discover(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->board_discover((bool)ctx->message_data[0]);
+}
+
+static enum kit_protocol_status kit_interpreter_board_get_last_error(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->board_get_last_error((uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_board_application(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->board_application(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_board_polling(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->board_polling((bool)ctx->message_data[0]);
+}
+
+static enum kit_protocol_status kit_interpreter_board_timing(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->board_timing((uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_board_script(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->board_script(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_board_profile(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->board_profile((uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_board_binary(struct kit_interpreter_ctx *ctx)
+{
+    // The framing changes once the response of this message is sent
+    ctx->binary_mode = ((ctx->message_length != 0) && (ctx->message_data[0] != 0)) ? true : false;
+    ctx->message_length = 0;
+
+    return KIT_STATUS_SUCCESS;
+}
+
+static enum kit_protocol_status kit_interpreter_device_idle(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->device_idle(ctx->selected_device_handle);
+}
+
+static enum kit_protocol_status kit_interpreter_device_sleep(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->device_sleep(ctx->selected_device_handle);
+}
+
+static enum kit_protocol_status kit_interpreter_device_wake(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->device_wake(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_device_send(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->device_send(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_device_receive(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->device_receive(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_device_talk(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->device_talk(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_memory_write(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->device_mem_write(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_memory_read(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->device_mem_read(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_device_transact(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->device_transact(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_device_talk_async(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->device_talk_async(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_device_poll(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->device_poll(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_device_cancel(struct kit_interpreter_ctx *ctx)
+{
+    return ctx->interface->device_cancel(ctx->selected_device_handle, (uint8_t*)ctx->message_data, &ctx->message_length);
+}
+
+static enum kit_protocol_status kit_interpreter_physical_select(struct kit_interpreter_ctx *ctx)
+{
+    // The device was selected while the message was parsed
+    ctx->message_length = 0;
+
+    return KIT_STATUS_SUCCESS;
+}
+
+/** \brief Resolves the command handler of an application's command handling function.
+ *
+ *  \param[in]    supported            Whether the application provides the command handling function
+ *                handler              The command handler calling the function
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The command handler
+ */
+static kit_command_handler_t kit_interpreter_resolve_handler(bool supported, kit_command_handler_t handler)
+{
+    return supported ? handler : kit_interpreter_command_not_supported;
+}
+
+/** \brief Resolves the command handlers of a context from its interface.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                  The interpreter context
+ *
+ *  \return None
+ */
+static void kit_interpreter_resolve_handlers(struct kit_interpreter_ctx *ctx)
 {
-    if (interface == NULL)
+    const struct kit_interpreter_interface *interface = ctx->interface;
+
+    ctx->handlers[KIT_SLOT_NONE] = kit_interpreter_command_none;
+    ctx->handlers[KIT_SLOT_BOARD_VERSION] = kit_interpreter_resolve_handler(interface->board_get_version != NULL, kit_interpreter_board_version);
+    ctx->handlers[KIT_SLOT_BOARD_FIRMWARE] = kit_interpreter_resolve_handler(interface->board_get_firmware != NULL, kit_interpreter_board_firmware);
+    ctx->handlers[KIT_SLOT_BOARD_GET_DEVICE] = kit_interpreter_resolve_handler(interface->board_get_device != NULL, kit_interpreter_board_get_device);
+    ctx->handlers[KIT_SLOT_BOARD_GET_DEVICES] = kit_interpreter_resolve_handler(interface->board_get_devices != NULL, kit_interpreter_board_get_devices);
+    ctx->handlers[KIT_SLOT_BOARD_DISCOVER] = kit_interpreter_resolve_handler(interface->board_discover != NULL, kit_interpreter_board_discover);
+    ctx->handlers[KIT_SLOT_BOARD_GET_LAST_ERROR] = kit_interpreter_resolve_handler(interface->board_get_last_error != NULL, kit_interpreter_board_get_last_error);
+    ctx->handlers[KIT_SLOT_BOARD_APPLICATION] = kit_interpreter_resolve_handler(interface->board_application != NULL, kit_interpreter_board_application);
+    ctx->handlers[KIT_SLOT_BOARD_POLLING] = kit_interpreter_resolve_handler(interface->board_polling != NULL, kit_interpreter_board_polling);
+    ctx->handlers[KIT_SLOT_BOARD_BINARY] = kit_interpreter_board_binary;
+    ctx->handlers[KIT_SLOT_BOARD_TIMING] = kit_interpreter_resolve_handler(interface->board_timing != NULL, kit_interpreter_board_timing);
+    ctx->handlers[KIT_SLOT_BOARD_SCRIPT] = kit_interpreter_resolve_handler(interface->board_script != NULL, kit_interpreter_board_script);
+    ctx->handlers[KIT_SLOT_BOARD_PROFILE] = kit_interpreter_resolve_handler(interface->board_profile != NULL, kit_interpreter_board_profile);
+    ctx->handlers[KIT_SLOT_DEVICE_IDLE] = kit_interpreter_resolve_handler(interface->device_idle != NULL, kit_interpreter_device_idle);
+    ctx->handlers[KIT_SLOT_DEVICE_SLEEP] = kit_interpreter_resolve_handler(interface->device_sleep != NULL, kit_interpreter_device_sleep);
+    ctx->handlers[KIT_SLOT_DEVICE_WAKE] = kit_interpreter_resolve_handler(interface->device_wake != NULL, kit_interpreter_device_wake);
+    ctx->handlers[KIT_SLOT_DEVICE_SEND] = kit_interpreter_resolve_handler(interface->device_send != NULL, kit_interpreter_device_send);
+    ctx->handlers[KIT_SLOT_DEVICE_RECEIVE] = kit_interpreter_resolve_handler(interface->device_receive != NULL, kit_interpreter_device_receive);
+    ctx->handlers[KIT_SLOT_DEVICE_TALK] = kit_interpreter_resolve_handler(interface->device_talk != NULL, kit_interpreter_device_talk);
+    ctx->handlers[KIT_SLOT_MEMORY_WRITE] = kit_interpreter_resolve_handler(interface->device_mem_write != NULL, kit_interpreter_memory_write);
+    ctx->handlers[KIT_SLOT_MEMORY_READ] = kit_interpreter_resolve_handler(interface->device_mem_read != NULL, kit_interpreter_memory_read);
+    ctx->handlers[KIT_SLOT_DEVICE_TRANSACT] = kit_interpreter_resolve_handler(interface->device_transact != NULL, kit_interpreter_device_transact);
+    ctx->handlers[KIT_SLOT_DEVICE_TALK_ASYNC] = kit_interpreter_resolve_handler(interface->device_talk_async != NULL, kit_interpreter_device_talk_async);
+    ctx->handlers[KIT_SLOT_DEVICE_POLL] = kit_interpreter_resolve_handler(interface->device_poll != NULL, kit_interpreter_device_poll);
+    ctx->handlers[KIT_SLOT_DEVICE_CANCEL] = kit_interpreter_resolve_handler(interface->device_cancel != NULL, kit_interpreter_device_cancel);
+    ctx->handlers[KIT_SLOT_PHYSICAL] = kit_interpreter_command_none;
+    ctx->handlers[KIT_SLOT_PHYSICAL_SELECT] = kit_interpreter_physical_select;
+}
+
+enum kit_protocol_status kit_interpreter_ctx_init(struct kit_interpreter_ctx *ctx, struct kit_interpreter_interface *interface)
+{
+    if ((ctx == NULL) || (interface == NULL))
     {
         return KIT_STATUS_INVALID_PARAM;
     }
 
-    // Save the interface
-    g_kit_interpreter_interface = interface;
+    // Select the ASCII hex conversion kernels
+    kit_hex_codec_init();
+
+    memset(ctx, 0, sizeof(*ctx));
+    kit_interpreter_stream_reset(ctx);
+
+    // Save the interface and resolve its command handlers once
+    ctx->interface = interface;
+    kit_interpreter_resolve_handlers(ctx);
+    kit_interpreter_set_command(ctx, KIT_SLOT_NONE);
+    ctx->selected_device_type = DEVICE_TYPE_UNKNOWN;
+    ctx->selected_interface_type = DEVKIT_IF_UNKNOWN;
 
     return KIT_STATUS_SUCCESS;
 }
 
-uint8_t kit_interpreter_get_selected_device_handle(void)
+enum kit_protocol_status kit_interpreter_init(struct kit_interpreter_interface *interface)
+{
+    return kit_interpreter_ctx_init(&g_kit_interpreter_ctx, interface);
+}
+
+struct kit_interpreter_ctx *kit_interpreter_get_default_ctx(void)
 {
-    return g_selected_device_handle;
+    return &g_kit_interpreter_ctx;
+}
 
+uint8_t kit_interpreter_get_selected_device_handle_ctx(const struct kit_interpreter_ctx *ctx)
+{
+    return ctx->selected_device_handle;
 }
 
-void kit_interpreter_set_selected_device_handle(const uint32_t handle)
+uint8_t kit_interpreter_get_selected_device_handle(void)
+{
+    return kit_interpreter_get_selected_device_handle_ctx(&g_kit_interpreter_ctx);
+}
+
+void kit_interpreter_set_selected_device_handle_ctx(struct kit_interpreter_ctx *ctx, const uint32_t handle)
 {
-    g_selected_device_handle = handle;
+    ctx->selected_device_handle = handle;
     const char *device_string;
     const char *header_string;
     device_info_t *select_handle;
@@ -653,48 +1155,27 @@ void kit_interpreter_set_selected_device_handle(const uint32_t handle)
     device_type_t dev_type = DEVICE_TYPE_UNKNOWN;
     ext_header header = EXT1_HEADER;
     uint8_t address = 0x00;
-    uint8_t i;
 
     //Adding below to avoid compilation error on UART with NO printf support
     (void)device_string;
     (void)header_string;
     (void)address;
-    
-    for (i = 0; i < MAX_DISCOVER_DEVICES; i++)
+
+    // Look the device up in the discovered device index, on the requested interface if any
+    select_handle = get_device_info_by_address(handle, ctx->selected_interface_type);
+    if (select_handle != NULL)
     {
-        select_handle = get_device_info(i);
+        address = select_handle->address;
+        interface = select_handle->bus_type;
+        dev_type = select_handle->device_type;
+        ctx->selected_device_type = dev_type;
+        header = select_handle->header;
+        ctx->selected_interface_type = DEVKIT_IF_UNKNOWN;
+    }
 
-        if (g_selected_interface_type != DEVKIT_IF_UNKNOWN)
-        {
-            if ((select_handle->address == handle) && 
-                ((select_handle->bus_type == g_selected_interface_type) || 
-                ((g_selected_interface_type == DEVKIT_IF_SWI) && 
-                    ((select_handle->bus_type == DEVKIT_IF_SWI) || 
-                    (select_handle->bus_type == DEVKIT_IF_SWI2)))))
-            {
-                address = select_handle->address;
-                interface = select_handle->bus_type;
-                dev_type = select_handle->device_type;
-                g_selected_device_type = dev_type;
-                header = select_handle->header;
-                g_selected_interface_type = DEVKIT_IF_UNKNOWN;
-                break;
-            }
-        }
-        else
-        {
-            if (select_handle->address == handle)
-            {
-                address = select_handle->address;
-                interface = select_handle->bus_type;
-                dev_type = select_handle->device_type;
-                g_selected_device_type = dev_type;
-                header = select_handle->header;
-                break;
-            }
-        }
+    // Cache the device for the command handlers
+    ctx->selected_device = select_handle;
 
-    }
     if ((interface == DEVKIT_IF_I2C) || (interface == DEVKIT_IF_SWI2))
     {
         device_string = get_device_string(dev_type);
@@ -712,273 +1193,356 @@ void kit_interpreter_set_selected_device_handle(const uint32_t handle)
         printf("%s \r\n", "Invalid device");
     }
 
+    // The HAL is shared by all contexts, keep the last selected device type for it
+    g_selected_device_type = ctx->selected_device_type;
+
     select_interface(interface);
 }
 
+device_info_t *kit_interpreter_get_selected_device_ctx(const struct kit_interpreter_ctx *ctx)
+{
+    return ctx->selected_device;
+}
+
+void kit_interpreter_set_selected_device_handle(const uint32_t handle)
+{
+    kit_interpreter_set_selected_device_handle_ctx(&g_kit_interpreter_ctx, handle);
+}
+
 uint16_t kit_interpreter_get_max_message_length(void)
 {
-    return (uint16_t)(sizeof(g_message_data));
+    return (uint16_t)(sizeof(g_kit_interpreter_ctx.message_data));
 }
 
 bool kit_interpreter_message_complete(const char *message, uint16_t message_length)
 {
-    char *delimiter_location = NULL;
+    const char *delimiter_location = NULL;
 
     if ((message == NULL) || (message_length == 0))
     {
         return false;
     }
 
-    // Find the message delimiter in the command message
-    delimiter_location = strrchr(message, KIT_MESSAGE_DELIMITER);
+    // Find the message delimiter within the received bytes only
+    delimiter_location = memchr(message, KIT_MESSAGE_DELIMITER, message_length);
 
     return (delimiter_location != NULL) ? true : false;
 }
 
-enum kit_protocol_status kit_interpreter_handle_message(char *message, uint16_t *message_length)
+/** \brief Runs the command handler of the parsed Kit Protocol message.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                  The interpreter context
+ *
+ *  \return the status of the command handler
+ */
+static enum kit_protocol_status kit_interpreter_execute(struct kit_interpreter_ctx *ctx)
 {
     enum kit_protocol_status status = KIT_STATUS_SUCCESS;
-    char error_message[KIT_ERROR_MESSAGE_SIZE];
 
-    if ((message == NULL) || (message_length == NULL))
+    // Process the Kit Protocol command message with the handler resolved at initialization
+    status = ctx->handlers[ctx->message_slot](ctx);
+
+    // Reset the message information, if necessary
+    if (status == KIT_STATUS_COMMAND_NOT_SUPPORTED)
     {
-        return KIT_STATUS_INVALID_PARAM;
+        ctx->message_length = 0;
+        memset(&ctx->message_data[0], 0, sizeof(ctx->message_data));
     }
 
-    memset(error_message, 0, sizeof(error_message));
+    return status;
+}
 
-    // Check if Kit Protocol command message is complete
-    if (kit_interpreter_message_complete(message, *message_length) == true)
+/** \brief Selects a device for the command handlers, on its own interface.
+ *
+ *  \param[in]    device               The device to select
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                  The interpreter context
+ *
+ *  \return None
+ */
+static void kit_interpreter_select_device(struct kit_interpreter_ctx *ctx, const device_info_t *device)
+{
+    ctx->selected_interface_type = device->bus_type;
+    kit_interpreter_set_selected_device_handle_ctx(ctx, device->address);
+}
+
+/** \brief Runs the command of a fan-out message on one device.
+ *
+ *  \param[in]    handle               The device handle
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                  The interpreter context
+ *                data                 As input, the command data
+ *                                     As output, the device response
+ *                length               As input, the length of the command data
+ *                                     As output, the length of the device response
+ *
+ *  \return the status of the application's command handling function
+ */
+static enum kit_protocol_status kit_interpreter_fanout_command(struct kit_interpreter_ctx *ctx, uint32_t handle, uint8_t *data,
+                                                               uint16_t *length)
+{
+    const struct kit_interpreter_interface *interface = ctx->interface;
+
+    switch (ctx->message_command)
     {
-        // Parse the Kit Protocol command message
-        status = kit_interpreter_parse(message, *message_length);
-        if (status == KIT_STATUS_SUCCESS)
+    case KIT_COMMAND_DEVICE_IDLE:
+        *length = 0;
+        return interface->device_idle(handle);
+    case KIT_COMMAND_DEVICE_SLEEP:
+        *length = 0;
+        return interface->device_sleep(handle);
+    case KIT_COMMAND_DEVICE_WAKE:
+        return interface->device_wake(handle, data, length);
+    case KIT_COMMAND_DEVICE_SEND:
+        return interface->device_send(handle, data, length);
+    case KIT_COMMAND_DEVICE_RECEIVE:
+        return interface->device_receive(handle, data, length);
+    case KIT_COMMAND_DEVICE_TALK:
+        return interface->device_talk(handle, data, length);
+    case KIT_COMMAND_DEVICE_TRANSACT:
+        return interface->device_transact(handle, data, length);
+    default:
+        *length = 0;
+        return KIT_STATUS_COMMAND_NOT_SUPPORTED;
+    }
+}
+
+/** \brief Runs the command of a fan-out message on each target device and packs
+ *         their responses: <count> then <device index><status><length:2><response>
+ *         for each device.
+ *
+ *  \note  The talk commands are all queued with device:talk_async first, when the
+ *         application supports it, so the devices execute them at the same time.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                  The interpreter context
+ *
+ *  \return KIT_STATUS_SUCCESS when the command succeeded on every device, otherwise the
+ *          status of the first device which failed
+ */
+static enum kit_protocol_status kit_interpreter_execute_fanout(struct kit_interpreter_ctx *ctx)
+{
+    enum kit_protocol_status status = KIT_STATUS_SUCCESS;
+    enum kit_protocol_status device_status;
+    uint8_t *data = (uint8_t*)ctx->message_data;
+    const uint16_t input_length = ctx->message_length;
+    // The command data moves to the end of the message data, the responses are packed from the start
+    uint8_t *input = &data[sizeof(ctx->message_data) - input_length];
+    const uint16_t limit = (uint16_t)min(((sizeof(ctx->message_data) - 1) / 2), (sizeof(ctx->message_data) - input_length));
+    const uint16_t reserved = (uint16_t)(KIT_FANOUT_ENTRY_HEADER_SIZE + ((input_length > KIT_FANOUT_RESPONSE_MAX) ? input_length : KIT_FANOUT_RESPONSE_MAX));
+    const device_info_t *selected = ctx->selected_device;
+    const uint32_t selected_handle = ctx->selected_device_handle;
+    const bool overlap = (ctx->message_command == KIT_COMMAND_DEVICE_TALK) && (ctx->interface->device_talk_async != NULL) &&
+                         (ctx->interface->device_poll != NULL) && (ctx->interface->device_cancel != NULL);
+    const device_info_t *device;
+    uint8_t tickets[MAX_DISCOVER_DEVICES];
+    uint32_t queued = 0;
+    uint32_t polls;
+#ifdef KIT_HAL_TIMER
+    uint32_t start_time;
+#endif // KIT_HAL_TIMER
+    uint16_t offset = 1;
+    uint16_t length;
+    uint8_t *entry;
+    uint8_t count = 0;
+    uint8_t device_index;
+
+    if (ctx->handlers[ctx->message_slot] == kit_interpreter_command_not_supported)
+    {
+        return KIT_STATUS_COMMAND_NOT_SUPPORTED;
+    }
+
+    memmove(input, data, input_length);
+
+    if (overlap)
+    {
+        // Start the command on every device before waiting for the first response
+        for (device_index = 0; device_index < MAX_DISCOVER_DEVICES; device_index++)
         {
-            // Process the Kit Protocol command message
-            switch (g_message_command)
+            if ((ctx->fanout_targets & (1UL << device_index)) != 0)
             {
-            case KIT_COMMAND_BOARD_VERSION:
-                if (g_kit_interpreter_interface->board_get_version != NULL)
-                {
-                    status = g_kit_interpreter_interface->board_get_version((uint8_t*)g_message_data, &g_message_length);
-                }
-                else
+                device = get_device_info(device_index);
+                kit_interpreter_select_device(ctx, device);
+                memcpy(data, input, input_length);
+                length = input_length;
+                if (ctx->interface->device_talk_async(device->address, data, &length) == KIT_STATUS_SUCCESS)
                 {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
+                    tickets[device_index] = data[0];
+                    queued |= (1UL << device_index);
                 }
-                break;
+            }
+        }
+    }
 
-            case KIT_COMMAND_BOARD_FIRMWARE:
-                if (g_kit_interpreter_interface->board_get_firmware != NULL)
-                {
-                    status = g_kit_interpreter_interface->board_get_firmware((uint8_t*)g_message_data, &g_message_length);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
+    for (device_index = 0; device_index < MAX_DISCOVER_DEVICES; device_index++)
+    {
+        if ((ctx->fanout_targets & (1UL << device_index)) == 0)
+        {
+            continue;
+        }
 
-            case KIT_COMMAND_BOARD_GET_DEVICE:
-                if (g_kit_interpreter_interface->board_get_device != NULL)
-                {
-                    status = g_kit_interpreter_interface->board_get_device(g_selected_device_handle, (uint8_t*)g_message_data, &g_message_length);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
+        if ((offset + reserved) > limit)
+        {
+            // The responses of the remaining devices do not fit
+            status = (status == KIT_STATUS_SUCCESS) ? KIT_STATUS_SMALL_BUFFER : status;
+            break;
+        }
 
-            case KIT_COMMAND_BOARD_GET_DEVICES:
-                if (g_kit_interpreter_interface->board_get_devices != NULL)
-                {
-                    status = g_kit_interpreter_interface->board_get_devices((uint8_t*)g_message_data, &g_message_length);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
+        device = get_device_info(device_index);
+        kit_interpreter_select_device(ctx, device);
+        entry = &data[offset];
 
-            case KIT_COMMAND_BOARD_DISCOVER:
-                if (g_kit_interpreter_interface->board_discover != NULL)
-                {
-                    status = g_kit_interpreter_interface->board_discover((bool)g_message_data[0]);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
+        if (overlap && ((queued & (1UL << device_index)) == 0))
+        {
+            // All the tickets were in use, there is one now
+            memcpy(&entry[KIT_FANOUT_ENTRY_HEADER_SIZE], input, input_length);
+            length = input_length;
+            if (ctx->interface->device_talk_async(device->address, &entry[KIT_FANOUT_ENTRY_HEADER_SIZE], &length) == KIT_STATUS_SUCCESS)
+            {
+                tickets[device_index] = entry[KIT_FANOUT_ENTRY_HEADER_SIZE];
+                queued |= (1UL << device_index);
+            }
+        }
 
-            case KIT_COMMAND_BOARD_GET_LAST_ERROR:
-                if (g_kit_interpreter_interface->board_get_last_error != NULL)
-                {
-                    status = g_kit_interpreter_interface->board_get_last_error((uint8_t*)g_message_data, &g_message_length);
-                }
-                else
+        if ((queued & (1UL << device_index)) != 0)
+        {
+#ifdef KIT_HAL_TIMER
+            start_time = kit_get_time_ms();
+#endif // KIT_HAL_TIMER
+            for (polls = 0; ; polls++)
+            {
+                entry[KIT_FANOUT_ENTRY_HEADER_SIZE] = tickets[device_index];
+                length = 1;
+                device_status = ctx->interface->device_poll(device->address, &entry[KIT_FANOUT_ENTRY_HEADER_SIZE], &length);
+                if (device_status != KIT_STATUS_PENDING)
                 {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
+                    break;
                 }
-                break;
 
-            case KIT_COMMAND_BOARD_APPLICATION:
-                if (g_kit_interpreter_interface->board_application != NULL)
+#ifdef KIT_HAL_TIMER
+                if ((kit_get_time_ms() - start_time) >= KIT_FANOUT_TIMEOUT_MS)
+#else
+                // Without a clock the delays of the polls count the time
+                if (polls >= ((KIT_FANOUT_TIMEOUT_MS * 1000UL) / KIT_FANOUT_POLL_US))
+#endif // KIT_HAL_TIMER
                 {
-                    status = g_kit_interpreter_interface->board_application(g_selected_device_handle, (uint8_t*)g_message_data, &g_message_length);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
+                    // The device never completed, its ticket is given up
+                    entry[KIT_FANOUT_ENTRY_HEADER_SIZE] = tickets[device_index];
+                    length = 1;
+                    (void)ctx->interface->device_cancel(device->address, &entry[KIT_FANOUT_ENTRY_HEADER_SIZE], &length);
+                    device_status = KIT_STATUS_RX_TIMEOUT;
+                    length = 0;
+                    break;
                 }
-                break;
 
-            case KIT_COMMAND_BOARD_POLLING:
-                if (g_kit_interpreter_interface->board_polling != NULL)
-                {
-                    status = g_kit_interpreter_interface->board_polling((bool)g_message_data[0]);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
+                kit_delay_us(KIT_FANOUT_POLL_US);
+            }
+        }
+        else
+        {
+            memcpy(&entry[KIT_FANOUT_ENTRY_HEADER_SIZE], input, input_length);
+            length = input_length;
+            device_status = kit_interpreter_fanout_command(ctx, device->address, &entry[KIT_FANOUT_ENTRY_HEADER_SIZE], &length);
+        }
 
-            case KIT_COMMAND_DEVICE_IDLE:
-                if (g_kit_interpreter_interface->device_idle != NULL)
-                {
-                    status = g_kit_interpreter_interface->device_idle(g_selected_device_handle);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
+        if (length > (reserved - KIT_FANOUT_ENTRY_HEADER_SIZE))
+        {
+            // The response overran the room of the device
+            device_status = KIT_STATUS_SMALL_BUFFER;
+            length = 0;
+        }
+        entry[0] = device_index;
+        entry[1] = (uint8_t)device_status;
+        entry[2] = (uint8_t)(length >> 8);
+        entry[3] = (uint8_t)length;
+        offset = (uint16_t)(offset + KIT_FANOUT_ENTRY_HEADER_SIZE + length);
+        count++;
+
+        if ((status == KIT_STATUS_SUCCESS) && (device_status != KIT_STATUS_SUCCESS))
+        {
+            status = device_status;
+        }
+    }
 
-            case KIT_COMMAND_DEVICE_SLEEP:
-                if (g_kit_interpreter_interface->device_sleep != NULL)
-                {
-                    status = g_kit_interpreter_interface->device_sleep(g_selected_device_handle);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
+    data[0] = count;
+    ctx->message_length = offset;
 
-            case KIT_COMMAND_DEVICE_WAKE:
-                if (g_kit_interpreter_interface->device_wake != NULL)
-                {
-                    status = g_kit_interpreter_interface->device_wake(g_selected_device_handle, (uint8_t*)g_message_data, &g_message_length);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
+    // Select the device of the other messages again
+    if (selected != NULL)
+    {
+        kit_interpreter_select_device(ctx, selected);
+    }
+    else
+    {
+        kit_interpreter_set_selected_device_handle_ctx(ctx, selected_handle);
+    }
 
-            case KIT_COMMAND_DEVICE_RECEIVE:
-                if (g_kit_interpreter_interface->device_receive != NULL)
-                {
-                    status = g_kit_interpreter_interface->device_receive(g_selected_device_handle, (uint8_t*)g_message_data, &g_message_length);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
+    return status;
+}
 
-            case KIT_COMMAND_DEVICE_SEND:
-                if (g_kit_interpreter_interface->device_send != NULL)
-                {
-                    status = g_kit_interpreter_interface->device_send(g_selected_device_handle, (uint8_t*)g_message_data, &g_message_length);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
+/** \brief Runs the parsed Kit Protocol message, on each device of its target list
+ *         when it has one.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                  The interpreter context
+ *
+ *  \return the status of the command
+ */
+static enum kit_protocol_status kit_interpreter_dispatch(struct kit_interpreter_ctx *ctx)
+{
+    return (ctx->fanout_targets != 0) ? kit_interpreter_execute_fanout(ctx) : kit_interpreter_execute(ctx);
+}
 
-            case KIT_COMMAND_DEVICE_TALK:
-                if (g_kit_interpreter_interface->device_talk != NULL)
-                {
-                    status = g_kit_interpreter_interface->device_talk(g_selected_device_handle, (uint8_t*)g_message_data, &g_message_length);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
-            case KIT_COMMAND_MEMORY_WRITE:
-                if (g_kit_interpreter_interface->device_mem_write != NULL)
-                {
-                    status = g_kit_interpreter_interface->device_mem_write(g_selected_device_handle, (uint8_t*)g_message_data, &g_message_length);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
-            case KIT_COMMAND_MEMORY_READ:
-                if (g_kit_interpreter_interface->device_mem_read != NULL)
-                {
-                    status = g_kit_interpreter_interface->device_mem_read(g_selected_device_handle, (uint8_t*)g_message_data, &g_message_length);
-                }
-                else
-                {
-                    // The Kit Protocol command is not supported in this application
-                    status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
-                }
-                break;
-            case KIT_COMMAND_PHYSICAL_SELECT:
-                g_message_length = 0;
+enum kit_protocol_status kit_interpreter_process_ctx(struct kit_interpreter_ctx *ctx, char *response, uint16_t *response_length)
+{
+    enum kit_protocol_status status = KIT_STATUS_SUCCESS;
 
-                break;
-            default:
-                // Unknown Kit Protocol command message
-                break;
-            }
+    if ((ctx == NULL) || (response == NULL) || (response_length == NULL))
+    {
+        return KIT_STATUS_INVALID_PARAM;
+    }
 
+    status = kit_interpreter_dispatch(ctx);
 
-            // Reset the message information, if necessary
-            if (status == KIT_STATUS_COMMAND_NOT_SUPPORTED)
-            {
-                g_message_length = 0;
-                memset(&g_message_data[0], 0, sizeof(g_message_data));
-            }
+    // Create the Kit Protocol response message
+    return kit_interpreter_serialize_ctx(ctx, status, response, response_length);
+}
 
+enum kit_protocol_status kit_interpreter_handle_message_ctx(struct kit_interpreter_ctx *ctx, char *message, uint16_t *message_length)
+{
+    enum kit_protocol_status status = KIT_STATUS_SUCCESS;
+    char error_message[KIT_ERROR_MESSAGE_SIZE];
 
-            // Create the Kit Protocol response message
-            switch (g_message_command)
-            {
-            case KIT_COMMAND_BOARD_VERSION:
-            case KIT_COMMAND_BOARD_FIRMWARE:
-            case KIT_COMMAND_BOARD_GET_DEVICE:
-                // Do nothing.  These command response messages do not need to be serialized
-                status = kit_interpreter_serialize(status, message, message_length);
-                break;
+    if ((ctx == NULL) || (message == NULL) || (message_length == NULL))
+    {
+        return KIT_STATUS_INVALID_PARAM;
+    }
 
-            default:
-                // Serialize the command response message
-                status = kit_interpreter_serialize(status, message, message_length);
-                break;
-            }
+    memset(error_message, 0, sizeof(error_message));
+
+    // Check if Kit Protocol command message is complete
+    if (kit_interpreter_message_complete(message, *message_length) == true)
+    {
+        // Parse the Kit Protocol command message
+        status = kit_interpreter_parse_ctx(ctx, message, *message_length);
+        if (status == KIT_STATUS_SUCCESS)
+        {
+            // Process the Kit Protocol command message and create the response message
+            status = kit_interpreter_process_ctx(ctx, message, message_length);
         }
         else
         {
@@ -988,12 +1552,21 @@ enum kit_protocol_status kit_interpreter_handle_message(char *message, uint16_t
     }
     else
     {
-        printf("Invalid command: %s\n", message);
+        printf("Invalid command: %.*s\n", (int)*message_length, message);
         kit_set_last_error((uint32_t)KIT_PROGRAM_INTERPRETER, (uint32_t)KIT_LOCATION_INTERPRETER_PARSE, (uint32_t)KIT_STATUS_COMMAND_NOT_VALID, error_message);
 
         status = KIT_STATUS_COMMAND_NOT_VALID;
     }
 
+    if (status != KIT_STATUS_SUCCESS)
+    {
+        // Answer the invalid message with its status, nothing was sent to the device; the
+        // message buffer holds KIT_MESSAGE_SIZE_MAX bytes, not only the request
+        kit_interpreter_set_command(ctx, KIT_SLOT_NONE);
+        ctx->message_length = 0;
+        (void)kit_interpreter_serialize_ctx(ctx, status, message, message_length);
+    }
+
     // Clear the last error data (if necessary)
     if (status == KIT_STATUS_SUCCESS)
     {
@@ -1002,3 +1575,387 @@ enum kit_protocol_status kit_interpreter_handle_message(char *message, uint16_t
 
     return status;
 }
+
+enum kit_protocol_status kit_interpreter_handle_pipeline_ctx(struct kit_interpreter_ctx *ctx, const char *messages, uint16_t messages_length,
+                                                              char *response, uint16_t response_size, uint16_t *response_length)
+{
+    enum kit_protocol_status status = KIT_STATUS_SUCCESS;
+    char error_message[KIT_ERROR_MESSAGE_SIZE];
+    const char *delimiter_location;
+    uint16_t offset = 0;
+    uint16_t length;
+    uint32_t required;
+
+    if ((ctx == NULL) || (messages == NULL) || (response == NULL) || (response_length == NULL))
+    {
+        return KIT_STATUS_INVALID_PARAM;
+    }
+
+    memset(error_message, 0, sizeof(error_message));
+    *response_length = 0;
+
+    // Run every complete message in order, a trailing incomplete message is ignored
+    while ((offset < messages_length) &&
+           ((delimiter_location = memchr(&messages[offset], KIT_MESSAGE_DELIMITER, messages_length - offset)) != NULL))
+    {
+        length = (uint16_t)(delimiter_location - &messages[offset]) + 1;
+
+        status = kit_interpreter_parse_ctx(ctx, &messages[offset], length);
+        if (status == KIT_STATUS_SUCCESS)
+        {
+            status = kit_interpreter_dispatch(ctx);
+        }
+        else
+        {
+            kit_set_last_error((uint32_t)KIT_PROGRAM_INTERPRETER, (uint32_t)KIT_LOCATION_INTERPRETER_PARSE, (uint32_t)status, error_message);
+
+            // There is no room to echo the request, respond with the error status
+            kit_interpreter_set_command(ctx, KIT_SLOT_NONE);
+            ctx->message_length = 0;
+        }
+        offset += length;
+
+        // The largest response is the ASCII hex data with the status, brackets,
+        // delimiter and the terminator written by the serializer
+        required = (2 * (uint32_t)ctx->message_length) + KIT_RESPONSE_OVERHEAD;
+        if (required > (uint32_t)(response_size - *response_length))
+        {
+            // Report the response which does not fit and stop at this message
+            if ((response_size - *response_length) >= KIT_RESPONSE_OVERHEAD)
+            {
+                kit_interpreter_set_command(ctx, KIT_SLOT_NONE);
+                ctx->message_length = 0;
+                (void)kit_interpreter_serialize_ctx(ctx, KIT_STATUS_SMALL_BUFFER, &response[*response_length], &length);
+                *response_length += length;
+            }
+            return KIT_STATUS_SMALL_BUFFER;
+        }
+
+        // Append the response of the message
+        (void)kit_interpreter_serialize_ctx(ctx, status, &response[*response_length], &length);
+        *response_length += length;
+
+        // Clear the last error data (if necessary)
+        if (status == KIT_STATUS_SUCCESS)
+        {
+            kit_clear_last_error();
+        }
+    }
+
+    return KIT_STATUS_SUCCESS;
+}
+
+/** \brief Finds the command handler slot of a binary frame opcode.
+ *
+ *  \param[in]    opcode               The binary frame opcode (a kit_protocol_command value)
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The command handler slot, KIT_SLOT_NONE when the opcode is not a command
+ */
+static enum kit_command_slot kit_interpreter_binary_slot(uint8_t opcode)
+{
+    uint8_t slot;
+
+    for (slot = KIT_SLOT_BOARD_VERSION; slot < KIT_SLOT_COUNT; slot++)
+    {
+        if ((slot != KIT_SLOT_PHYSICAL) && ((uint8_t)g_kit_slot_command[slot] == opcode))
+        {
+            return (enum kit_command_slot)slot;
+        }
+    }
+
+    return KIT_SLOT_NONE;
+}
+
+enum kit_protocol_status kit_interpreter_handle_binary_ctx(struct kit_interpreter_ctx *ctx, uint8_t *frame, uint16_t *frame_length)
+{
+    enum kit_protocol_status status = KIT_STATUS_SUCCESS;
+    char error_message[KIT_ERROR_MESSAGE_SIZE];
+    enum kit_command_slot slot = KIT_SLOT_NONE;
+    bool executed = false;
+    uint32_t handle;
+    uint16_t length;
+
+    if ((ctx == NULL) || (frame == NULL) || (frame_length == NULL))
+    {
+        return KIT_STATUS_INVALID_PARAM;
+    }
+
+    kit_interpreter_set_command(ctx, KIT_SLOT_NONE);
+    ctx->message_length = 0;
+    // The binary frames address one device, not the target list of an earlier message
+    ctx->fanout_targets = 0;
+
+    if ((*frame_length != 0) && (frame[0] == KIT_BINARY_ESCAPE))
+    {
+        // Return to the ASCII messages
+        ctx->binary_mode = false;
+    }
+    else if (kit_interpreter_frame_complete_ctx(ctx, frame, *frame_length) == false)
+    {
+        status = KIT_STATUS_COMMAND_NOT_VALID;
+    }
+    else
+    {
+        slot = kit_interpreter_binary_slot(frame[0]);
+        handle = ((uint32_t)frame[1] << 24) | ((uint32_t)frame[2] << 16) | ((uint32_t)frame[3] << 8) | (uint32_t)frame[4];
+        length = (uint16_t)((frame[5] << 8) | frame[6]);
+
+        if (slot == KIT_SLOT_NONE)
+        {
+            // Unknown Kit Protocol command
+            status = KIT_STATUS_COMMAND_NOT_VALID;
+        }
+        else if (length > (sizeof(ctx->message_data) - 1))
+        {
+            // The message data does not fit in the message buffer
+            status = KIT_STATUS_INVALID_SIZE;
+        }
+        else if ((slot == KIT_SLOT_PHYSICAL_SELECT) && (length != 1))
+        {
+            // The device select command requires the device index
+            status = KIT_STATUS_COMMAND_NOT_VALID;
+        }
+        else
+        {
+            // The payload is raw binary, nothing to convert
+            memcpy(ctx->message_data, &frame[KIT_BINARY_REQUEST_HEADER_SIZE], length);
+            ctx->message_data[length] = '\0';
+            ctx->message_length = length;
+
+            if (slot == KIT_SLOT_PHYSICAL_SELECT)
+            {
+                kit_interpreter_set_selected_device_handle_ctx(ctx, (uint8_t)ctx->message_data[0]);
+            }
+            else if (handle != KIT_BINARY_HANDLE_NONE)
+            {
+                kit_interpreter_set_selected_device_handle_ctx(ctx, handle);
+            }
+
+            kit_interpreter_set_command(ctx, slot);
+            status = kit_interpreter_dispatch(ctx);
+            executed = true;
+        }
+    }
+
+    if (status == KIT_STATUS_SUCCESS)
+    {
+        kit_clear_last_error();
+    }
+    else if (executed == false)
+    {
+        memset(error_message, 0, sizeof(error_message));
+        kit_set_last_error((uint32_t)KIT_PROGRAM_INTERPRETER, (uint32_t)KIT_LOCATION_INTERPRETER_PARSE, (uint32_t)status, error_message);
+    }
+
+    // Create the binary response frame with the handler data
+    frame[0] = (uint8_t)status;
+    frame[1] = (uint8_t)(ctx->message_length >> 8);
+    frame[2] = (uint8_t)ctx->message_length;
+    memcpy(&frame[KIT_BINARY_RESPONSE_HEADER_SIZE], ctx->message_data, ctx->message_length);
+    *frame_length = KIT_BINARY_RESPONSE_HEADER_SIZE + ctx->message_length;
+
+    return status;
+}
+
+bool kit_interpreter_frame_complete_ctx(const struct kit_interpreter_ctx *ctx, const uint8_t *buffer, uint16_t length)
+{
+    if ((ctx == NULL) || (buffer == NULL) || (length == 0))
+    {
+        return false;
+    }
+
+    if (ctx->binary_mode == false)
+    {
+        return kit_interpreter_message_complete((const char*)buffer, length);
+    }
+
+    if (buffer[0] == KIT_BINARY_ESCAPE)
+    {
+        return true;
+    }
+
+    return ((length >= KIT_BINARY_REQUEST_HEADER_SIZE) &&
+            ((length - KIT_BINARY_REQUEST_HEADER_SIZE) >= ((buffer[5] << 8) | buffer[6]))) ? true : false;
+}
+
+void kit_interpreter_stream_reset(struct kit_interpreter_ctx *ctx)
+{
+    struct kit_interpreter_stream *stream = &ctx->stream;
+
+    memset(&stream->tokens, 0, sizeof(stream->tokens));
+    stream->state = KIT_TOKENIZER_TARGET;
+    stream->status = KIT_STATUS_SUCCESS;
+    stream->index = 0;
+    stream->nibble = 0;
+    stream->nibble_pending = false;
+    stream->ready = false;
+    ctx->message_length = 0;
+}
+
+bool kit_interpreter_feed(struct kit_interpreter_ctx *ctx, uint8_t character)
+{
+    struct kit_interpreter_stream *stream = &ctx->stream;
+    enum kit_tokenizer_state previous_state = stream->state;
+    uint8_t nibble;
+
+    if (stream->ready)
+    {
+        // The previous message has not been processed yet
+        return false;
+    }
+
+    if (character == KIT_MESSAGE_DELIMITER)
+    {
+        if (stream->status == KIT_STATUS_SUCCESS)
+        {
+            stream->status = kit_interpreter_tokenize_end(stream->state, &stream->tokens, stream->index);
+        }
+
+        if (stream->status == KIT_STATUS_SUCCESS)
+        {
+            ctx->message_data[ctx->message_length] = '\0';
+
+            // An odd trailing character has no lower nibble, the sections are parsed out of the interrupt
+            stream->status = (stream->nibble_pending) ? KIT_STATUS_COMMAND_NOT_VALID : KIT_STATUS_SUCCESS;
+        }
+
+        stream->ready = true;
+        return true;
+    }
+
+    if (stream->status != KIT_STATUS_SUCCESS)
+    {
+        // Discard the rest of an invalid message
+        return false;
+    }
+
+    if (stream->index == 0)
+    {
+        // The message data may still hold the previous response
+        ctx->message_length = 0;
+    }
+
+    if (stream->index < sizeof(stream->header))
+    {
+        stream->header[stream->index] = (char)character;
+    }
+
+    stream->status = kit_interpreter_tokenize_char(&stream->state, &stream->tokens, (char)character, stream->index);
+
+    if ((stream->state == KIT_TOKENIZER_DATA) && (previous_state == KIT_TOKENIZER_DATA))
+    {
+        // Convert the ASCII hex data to binary as it arrives
+        nibble = g_kit_hex_decode_table[character];
+        if (nibble & KIT_HEX_INVALID)
+        {
+            // Not an ASCII hex character, reject the message before it reaches the device
+            stream->status = KIT_STATUS_COMMAND_NOT_VALID;
+        }
+        else if (stream->nibble_pending)
+        {
+            if (ctx->message_length < (sizeof(ctx->message_data) - 1))
+            {
+                ctx->message_data[ctx->message_length++] = (char)((stream->nibble << 4) | nibble);
+            }
+            else
+            {
+                // The message data does not fit in the message buffer
+                stream->status = KIT_STATUS_COMMAND_NOT_VALID;
+            }
+        }
+        stream->nibble = nibble;
+        stream->nibble_pending = !stream->nibble_pending;
+    }
+    else if ((stream->state != KIT_TOKENIZER_DATA) && (stream->state != KIT_TOKENIZER_DATA_END) &&
+             (stream->index >= sizeof(stream->header)))
+    {
+        // The target, command and subcommand sections must fit in the header buffer
+        stream->status = KIT_STATUS_COMMAND_NOT_VALID;
+    }
+
+    if (stream->index < UINT16_MAX)
+    {
+        stream->index++;
+    }
+    else
+    {
+        stream->status = KIT_STATUS_COMMAND_NOT_VALID;
+    }
+
+    return false;
+}
+
+uint16_t kit_interpreter_feed_buffer(struct kit_interpreter_ctx *ctx, const uint8_t *buffer, uint16_t length)
+{
+    uint16_t index = 0;
+
+    if ((ctx == NULL) || (buffer == NULL))
+    {
+        return 0;
+    }
+
+    while ((index < length) && (ctx->stream.ready == false))
+    {
+        (void)kit_interpreter_feed(ctx, buffer[index++]);
+    }
+
+    return index;
+}
+
+bool kit_interpreter_stream_ready(const struct kit_interpreter_ctx *ctx)
+{
+    return ctx->stream.ready;
+}
+
+enum kit_protocol_status kit_interpreter_handle_stream_ctx(struct kit_interpreter_ctx *ctx, char *response, uint16_t *response_length)
+{
+    enum kit_protocol_status status = KIT_STATUS_SUCCESS;
+    char error_message[KIT_ERROR_MESSAGE_SIZE];
+
+    if ((ctx == NULL) || (response == NULL) || (response_length == NULL) || (ctx->stream.ready == false))
+    {
+        return KIT_STATUS_INVALID_PARAM;
+    }
+
+    status = ctx->stream.status;
+    if (status == KIT_STATUS_SUCCESS)
+    {
+        // The data was converted while it was received, only the sections are left to parse
+        status = kit_interpreter_parse_sections(ctx, ctx->stream.header, &ctx->stream.tokens);
+    }
+
+    if (status == KIT_STATUS_SUCCESS)
+    {
+        status = kit_interpreter_process_ctx(ctx, response, response_length);
+    }
+    else
+    {
+        memset(error_message, 0, sizeof(error_message));
+        kit_set_last_error((uint32_t)KIT_PROGRAM_INTERPRETER, (uint32_t)KIT_LOCATION_INTERPRETER_PARSE, (uint32_t)status, error_message);
+
+        // There is no request buffer to return, respond with the error status
+        kit_interpreter_set_command(ctx, KIT_SLOT_NONE);
+        ctx->message_length = 0;
+        (void)kit_interpreter_serialize_ctx(ctx, status, response, response_length);
+    }
+
+    // Clear the last error data (if necessary)
+    if (status == KIT_STATUS_SUCCESS)
+    {
+        kit_clear_last_error();
+    }
+
+    // Accept the next message
+    kit_interpreter_stream_reset(ctx);
+
+    return status;
+}
+
+enum kit_protocol_status kit_interpreter_handle_message(char *message, uint16_t *message_length)
+{
+    return kit_interpreter_handle_message_ctx(&g_kit_interpreter_ctx, message, message_length);
+}
@@ -43,8 +43,8 @@
 extern device_type_t g_selected_device_type;
 extern const char *interface_string[];
 
-// Set the packing alignment for the structure members
-#pragma pack(push, 1)
+// The interpreter structures keep their natural alignment, the handlers take
+// the address of the context members (Ex. &ctx->message_length)
 
 #ifdef __cplusplus
 extern "C" {
@@ -66,6 +66,10 @@ enum kit_protocol_command
     KIT_COMMAND_BOARD_GET_LAST_ERROR = 0x06,
     KIT_COMMAND_BOARD_APPLICATION    = 0x07,
     KIT_COMMAND_BOARD_POLLING        = 0x08,
+    KIT_COMMAND_BOARD_BINARY         = 0x09,
+    KIT_COMMAND_BOARD_TIMING         = 0x0A,
+    KIT_COMMAND_BOARD_SCRIPT         = 0x0B,
+    KIT_COMMAND_BOARD_PROFILE        = 0x0C,
 
     KIT_COMMAND_DEVICE               = 0x30,
     KIT_COMMAND_DEVICE_IDLE          = 0x31,
@@ -76,6 +80,10 @@ enum kit_protocol_command
     KIT_COMMAND_DEVICE_TALK          = 0x36,
     KIT_COMMAND_MEMORY_WRITE         = 0x37,
     KIT_COMMAND_MEMORY_READ          = 0x38,
+    KIT_COMMAND_DEVICE_TRANSACT      = 0x39,
+    KIT_COMMAND_DEVICE_TALK_ASYNC    = 0x3A,
+    KIT_COMMAND_DEVICE_POLL          = 0x3B,
+    KIT_COMMAND_DEVICE_CANCEL        = 0x3C,
 
 #ifndef KIT_PROTOCOL_NO_LEGACY_SUPPORT
     KIT_COMMAND_PHYSICAL             = 0xF0,
@@ -83,9 +91,125 @@ enum kit_protocol_command
 #endif // KIT_PROTOCOL_NO_LEGACY_SUPPORT
 };
 
+/**
+ * \brief The command handler slots of a Kit Protocol Interpreter context.
+ *
+ * The command words are resolved to a slot while the message is parsed and the
+ * slot handlers are resolved once when the context is initialized, so commands
+ * not supported by the application share a single "not supported" handler.
+ */
+enum kit_command_slot
+{
+    KIT_SLOT_NONE                    = 0x00,    //!< Nothing to process (Ex. device:physical:int:i2c)
+    KIT_SLOT_BOARD_VERSION,
+    KIT_SLOT_BOARD_FIRMWARE,
+    KIT_SLOT_BOARD_GET_DEVICE,
+    KIT_SLOT_BOARD_GET_DEVICES,
+    KIT_SLOT_BOARD_DISCOVER,
+    KIT_SLOT_BOARD_GET_LAST_ERROR,
+    KIT_SLOT_BOARD_APPLICATION,
+    KIT_SLOT_BOARD_POLLING,
+    KIT_SLOT_BOARD_BINARY,
+    KIT_SLOT_BOARD_TIMING,
+    KIT_SLOT_BOARD_SCRIPT,
+    KIT_SLOT_BOARD_PROFILE,
+    KIT_SLOT_DEVICE_IDLE,
+    KIT_SLOT_DEVICE_SLEEP,
+    KIT_SLOT_DEVICE_WAKE,
+    KIT_SLOT_DEVICE_SEND,
+    KIT_SLOT_DEVICE_RECEIVE,
+    KIT_SLOT_DEVICE_TALK,
+    KIT_SLOT_MEMORY_WRITE,
+    KIT_SLOT_MEMORY_READ,
+    KIT_SLOT_DEVICE_TRANSACT,
+    KIT_SLOT_DEVICE_TALK_ASYNC,
+    KIT_SLOT_DEVICE_POLL,
+    KIT_SLOT_DEVICE_CANCEL,
+    KIT_SLOT_PHYSICAL,
+    KIT_SLOT_PHYSICAL_SELECT,
+
+    KIT_SLOT_COUNT
+};
+
+struct kit_interpreter_ctx;
+
+/**
+ * \brief A Kit Protocol command handler. It processes the context message data
+ *        and leaves the response data in it.
+ */
+typedef enum kit_protocol_status (*kit_command_handler_t)(struct kit_interpreter_ctx *ctx);
+
 #define KIT_DEVICE_HANDLE_SIZE  (8)  //! Size of the device handle ASCII hex string
+#define KIT_FANOUT_ALL          '*'  //! The target list of all the discovered devices (Ex. device(*):talk(...))
+#define KIT_FANOUT_SEPARATOR    ','  //! The separator of the target list device indexes
 #define KIT_DEVICE_INDEX_SIZE  (2)   //! Size of the device index ASCII hex string
 #define KIT_COMMAND_SIZE_MIN   (3)   //! Minimum size of a command section name (Ex. v())
+#define KIT_STREAM_HEADER_SIZE (48)  //! Size of the streamed <target>:<command>:<subcommand> sections
+#define KIT_BINARY_REQUEST_HEADER_SIZE  (7)           //! Size of the binary request frame header: opcode, handle, length
+#define KIT_BINARY_RESPONSE_HEADER_SIZE (3)           //! Size of the binary response frame header: status, length
+#define KIT_BINARY_ESCAPE               (0x1B)        //! Reserved opcode leaving the binary framing mode
+#define KIT_BINARY_HANDLE_NONE          (0xFFFFFFFF)  //! Binary frame handle keeping the selected device
+#define KIT_RESPONSE_OVERHEAD  (6)   //! Size of a response message without data, including the terminator (Ex. 00()\n\0)
+
+/**
+ * \brief Location of a section inside a Kit Protocol command message.
+ */
+struct kit_message_span
+{
+    uint16_t offset;    //!< Offset, in bytes, of the section from the start of the message
+    uint16_t length;    //!< Length, in bytes, of the section (0 when the section is absent)
+};
+
+/**
+ * \brief The sections of a Kit Protocol command message.
+ * \note
+ *    <target>[(<handle>)]:<command>[:<subcommand>][(<data>)]\n
+ *
+ *    All sections refer to the original message buffer, which is neither
+ *    copied nor modified by the tokenizer.
+ */
+struct kit_message_tokens
+{
+    struct kit_message_span target;       //!< The target name (Ex. board, device)
+    struct kit_message_span handle;       //!< The optional target device handle
+    struct kit_message_span command;      //!< The command name (Ex. version, talk)
+    struct kit_message_span subcommand;   //!< The optional subcommand (Ex. select, int:swi)
+    struct kit_message_span data;         //!< The ASCII hex data between the data delimiters
+    bool     has_data;                    //!< Whether the data delimiters were present
+    uint16_t message_length;              //!< The length, in bytes, of the message including the message delimiter
+};
+
+/**
+ * \brief The states of the Kit Protocol message tokenizer.
+ */
+enum kit_tokenizer_state
+{
+    KIT_TOKENIZER_TARGET,
+    KIT_TOKENIZER_HANDLE,
+    KIT_TOKENIZER_TARGET_END,
+    KIT_TOKENIZER_COMMAND,
+    KIT_TOKENIZER_SUBCOMMAND,
+    KIT_TOKENIZER_DATA,
+    KIT_TOKENIZER_DATA_END
+};
+
+/**
+ * \brief Incremental parser state of a message received byte by byte.
+ *
+ * The sections before the data are kept in a small header buffer and the
+ * ASCII hex data is converted into the context message data as it arrives.
+ */
+struct kit_interpreter_stream
+{
+    enum kit_tokenizer_state state;                  //!< The tokenizer state
+    struct kit_message_tokens tokens;                //!< The sections located so far
+    enum kit_protocol_status status;                 //!< The parse status of the current message
+    uint16_t index;                                  //!< The number of message bytes received
+    uint8_t nibble;                                  //!< The upper nibble of the data byte being converted
+    bool nibble_pending;                             //!< Whether the upper nibble has been received
+    volatile bool ready;                             //!< A complete message is received and waits to be processed
+    char header[KIT_STREAM_HEADER_SIZE];             //!< The message bytes before the data section
+};
 
 /**
  * \brief Kit Protocol Interpreter interface to the application.
@@ -101,6 +225,9 @@ struct kit_interpreter_interface
     enum kit_protocol_status (*board_get_last_error)(uint8_t *message, uint16_t *message_length);
     enum kit_protocol_status (*board_application)(uint32_t device_handle, uint8_t *message, uint16_t *message_length);
     enum kit_protocol_status (*board_polling)(bool enabled);
+    enum kit_protocol_status (*board_timing)(uint8_t *message, uint16_t *message_length);
+    enum kit_protocol_status (*board_script)(uint32_t device_handle, uint8_t *message, uint16_t *message_length);
+    enum kit_protocol_status (*board_profile)(uint8_t *message, uint16_t *message_length);
 
     // Device Kit Protocol message functions
     enum kit_protocol_status (*device_idle)(uint32_t device_handle);
@@ -111,6 +238,37 @@ struct kit_interpreter_interface
     enum kit_protocol_status (*device_talk)(uint32_t device_handle, uint8_t *message, uint16_t *message_length);
     enum kit_protocol_status (*device_mem_write)(uint32_t device_handle, uint8_t *message, uint16_t *message_length);
     enum kit_protocol_status (*device_mem_read)(uint32_t device_handle, uint8_t *message, uint16_t *message_length);
+    enum kit_protocol_status (*device_transact)(uint32_t device_handle, uint8_t *message, uint16_t *message_length);
+    enum kit_protocol_status (*device_talk_async)(uint32_t device_handle, uint8_t *message, uint16_t *message_length);
+    enum kit_protocol_status (*device_poll)(uint32_t device_handle, uint8_t *message, uint16_t *message_length);
+    enum kit_protocol_status (*device_cancel)(uint32_t device_handle, uint8_t *message, uint16_t *message_length);
+};
+
+/**
+ * \brief Kit Protocol Interpreter session state.
+ *
+ * Each context keeps its own parser state, message data and selected device,
+ * so the messages of several host sessions may be interleaved. The contexts
+ * share the application command handlers, and the kit_protocol_init.c ones
+ * find the device information through the default context and use global
+ * HAL and device state: they run one message at a time, from a single task.
+ * The legacy API without the _ctx suffix operates on a default context.
+ */
+struct kit_interpreter_ctx
+{
+    struct kit_interpreter_interface *interface;     //!< The application command handlers
+    enum kit_protocol_command message_command;       //!< The command of the current message
+    enum kit_command_slot message_slot;              //!< The handler slot of the current message
+    uint16_t message_length;                         //!< The length, in bytes, of the current message data
+    uint32_t selected_device_handle;                 //!< The currently selected device handle
+    device_type_t selected_device_type;              //!< The currently selected device type
+    device_info_t *selected_device;                  //!< The currently selected device information (NULL when not discovered)
+    interface_id_t selected_interface_type;          //!< The interface requested for the next device selection
+    uint32_t fanout_targets;                         //!< The device indexes of a device(<index>,...) message, one bit each (0 for one device)
+    bool binary_mode;                                //!< The messages use the binary framing
+    struct kit_interpreter_stream stream;            //!< The byte by byte message parser state
+    kit_command_handler_t handlers[KIT_SLOT_COUNT];  //!< The command handlers resolved at initialization
+    char message_data[KIT_MESSAGE_SIZE_MAX];         //!< The current message data (binary)
 };
 
 /** \brief Initialize the Kit Protocol Interpreter library.
@@ -125,6 +283,30 @@ struct kit_interpreter_interface
  */
 enum kit_protocol_status kit_interpreter_init(struct kit_interpreter_interface *interface);
 
+/** \brief Initialize a Kit Protocol Interpreter context.
+ *
+ *  \param[in]    interface              references to the Kit interpreter interface
+ *
+ *  \param[out]   ctx                    references to the context to be initialized
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise error code
+ */
+enum kit_protocol_status kit_interpreter_ctx_init(struct kit_interpreter_ctx *ctx, struct kit_interpreter_interface *interface);
+
+/** \brief Get the default context used by the API without the _ctx suffix
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the default context
+ */
+struct kit_interpreter_ctx *kit_interpreter_get_default_ctx(void);
+
 /** \brief Get the selected device - device address
  *
  *  \param[in]    None
@@ -137,6 +319,18 @@ enum kit_protocol_status kit_interpreter_init(struct kit_interpreter_interface *
  */
 uint8_t kit_interpreter_get_selected_device_handle(void);
 
+/** \brief Get the selected device of a context - device address
+ *
+ *  \param[in]    ctx                    references to the interpreter context
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the device address
+ */
+uint8_t kit_interpreter_get_selected_device_handle_ctx(const struct kit_interpreter_ctx *ctx);
+
 /** \brief The function select the hal interface based on device interface selected
  *
  *  \param[in]    handle                 references to device address
@@ -149,6 +343,30 @@ uint8_t kit_interpreter_get_selected_device_handle(void);
  */
 void kit_interpreter_set_selected_device_handle(const uint32_t handle);
 
+/** \brief The function selects the device of a context and the hal interface of that device
+ *
+ *  \param[in]    handle                 references to device address
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                    references to the interpreter context
+ *
+ *  \return None
+ */
+void kit_interpreter_set_selected_device_handle_ctx(struct kit_interpreter_ctx *ctx, const uint32_t handle);
+
+/** \brief Get the device information of the currently selected device of a context
+ *
+ *  \param[in]    ctx                    references to the interpreter context
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the device information, NULL when the device was not discovered
+ */
+device_info_t *kit_interpreter_get_selected_device_ctx(const struct kit_interpreter_ctx *ctx);
+
 /** \brief Get the Kit Protocol maximum message length
  *
  *  \param[in]    None
@@ -174,6 +392,21 @@ uint16_t kit_interpreter_get_max_message_length(void);
  */
 bool kit_interpreter_message_complete(const char *message, uint16_t message_length);
 
+/** \brief The function locates the sections of a Kit Protocol command message
+ *         in a single pass without copying or modifying the message
+ *
+ *  \param[in]    message                references to command message
+ *                message_length         references to command message length
+ *
+ *  \param[out]   tokens                 references to the located message sections
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+enum kit_protocol_status kit_interpreter_tokenize(const char *message, uint16_t message_length,
+                                                  struct kit_message_tokens *tokens);
+
 /** \brief The function interprets the received message and handle it
  *
  *  \param[in]    message                references to command message
@@ -187,11 +420,193 @@ bool kit_interpreter_message_complete(const char *message, uint16_t message_leng
  */
 enum kit_protocol_status kit_interpreter_handle_message(char *message, uint16_t *message_length);
 
+/** \brief The function interprets the received message and handle it within a context
+ *
+ *  \note  The message buffer holds KIT_MESSAGE_SIZE_MAX bytes, the response (Ex. the
+ *         XX() status of an invalid message) is longer than the request.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                    references to the interpreter context
+ *                message                As input, references to command message
+ *                                       As output, references to response message
+ *                message_length         As input, references to command message length
+ *                                       As output, references to response message length
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+enum kit_protocol_status kit_interpreter_handle_message_ctx(struct kit_interpreter_ctx *ctx, char *message, uint16_t *message_length);
+
+/** \brief The function processes the parsed command of a context and creates the response message
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   response               references to response message
+ *
+ *  \param[inout] ctx                    references to the interpreter context
+ *                response_length        references to response message length
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+enum kit_protocol_status kit_interpreter_process_ctx(struct kit_interpreter_ctx *ctx, char *response, uint16_t *response_length);
+
+/** \brief The function handles every complete message of a buffer in order and
+ *         appends their responses into one response buffer
+ *
+ *  \note  A message whose response does not fit in the response buffer is answered
+ *         with KIT_STATUS_SMALL_BUFFER and the following messages are not run.
+ *
+ *  \param[in]    messages               references to newline delimited command messages
+ *                messages_length        references to length of the command messages
+ *                response_size          references to size of the response buffer
+ *
+ *  \param[out]   response               references to the response messages
+ *                response_length        references to length of the response messages
+ *
+ *  \param[inout] ctx                    references to the interpreter context
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+enum kit_protocol_status kit_interpreter_handle_pipeline_ctx(struct kit_interpreter_ctx *ctx, const char *messages, uint16_t messages_length,
+                                                              char *response, uint16_t response_size, uint16_t *response_length);
+
+/** \brief The function handles a binary framed message and creates the binary
+ *         framed response in the same buffer. The binary framing is enabled by
+ *         the board:binary(01) message.
+ *  \note
+ *    Request:  <opcode:1><handle:4><length:2><payload:length>
+ *    Response: <status:1><length:2><payload:length>
+ *
+ *    Multi-byte fields are big-endian. The opcode is a kit_protocol_command value,
+ *    a KIT_BINARY_HANDLE_NONE handle keeps the selected device and a single
+ *    KIT_BINARY_ESCAPE byte returns to the ASCII messages.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                    references to the interpreter context
+ *                frame                  references to request and response frame
+ *                frame_length           references to request and response frame length
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+enum kit_protocol_status kit_interpreter_handle_binary_ctx(struct kit_interpreter_ctx *ctx, uint8_t *frame, uint16_t *frame_length);
+
+/** \brief The function checks whether a complete message was received, with the
+ *         framing currently used by the context
+ *
+ *  \param[in]    ctx                    references to the interpreter context
+ *                buffer                 references to received message
+ *                length                 references to received message length
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return True when the message is complete, otherwise false
+ */
+bool kit_interpreter_frame_complete_ctx(const struct kit_interpreter_ctx *ctx, const uint8_t *buffer, uint16_t length);
+
+/** \brief The function resets the byte by byte message parser of a context
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                    references to the interpreter context
+ *
+ *  \return None
+ */
+void kit_interpreter_stream_reset(struct kit_interpreter_ctx *ctx);
+
+/** \brief The function parses one received message byte. It can be called from
+ *         the receive interrupt, it only locates the message sections and converts
+ *         the data; the sections are parsed by kit_interpreter_handle_stream_ctx.
+ *
+ *  \note  Bytes are not accepted while a received message waits to be processed
+ *         with kit_interpreter_handle_stream_ctx.
+ *
+ *  \param[in]    character              references to received byte
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                    references to the interpreter context
+ *
+ *  \return True when the byte completed a message, otherwise false
+ */
+bool kit_interpreter_feed(struct kit_interpreter_ctx *ctx, uint8_t character);
+
+/** \brief The function parses received message bytes up to the end of the first
+ *         complete message
+ *
+ *  \param[in]    buffer                 references to received bytes
+ *                length                 references to number of received bytes
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                    references to the interpreter context
+ *
+ *  \return the number of bytes consumed
+ */
+uint16_t kit_interpreter_feed_buffer(struct kit_interpreter_ctx *ctx, const uint8_t *buffer, uint16_t length);
+
+/** \brief The function checks whether a streamed message is received and waits to be processed
+ *
+ *  \param[in]    ctx                    references to the interpreter context
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return True when a message is ready, otherwise false
+ */
+bool kit_interpreter_stream_ready(const struct kit_interpreter_ctx *ctx);
+
+/** \brief The function processes the streamed message and creates the response message
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   response               references to response message
+ *
+ *  \param[inout] ctx                    references to the interpreter context
+ *                response_length        references to response message length
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+enum kit_protocol_status kit_interpreter_handle_stream_ctx(struct kit_interpreter_ctx *ctx, char *response, uint16_t *response_length);
+
+/** \brief The function parses the received message into a context
+ *
+ *  \param[in]    message                references to command message
+ *                message_length         references to command message length
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] ctx                    references to the interpreter context
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+enum kit_protocol_status kit_interpreter_parse_ctx(struct kit_interpreter_ctx *ctx, const char *message, uint16_t message_length);
+
+/** \brief The function serializes the response message of a context
+ *
+ *  \param[in]    status                 references to the command status
+ *
+ *  \param[out]   response               references to response message
+ *
+ *  \param[inout] ctx                    references to the interpreter context
+ *                response_length        references to response message length
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+enum kit_protocol_status kit_interpreter_serialize_ctx(struct kit_interpreter_ctx *ctx, enum kit_protocol_status status,
+                                                       char *response, uint16_t *response_length);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
 
-// unset the packing alignment for the structure members
-#pragma pack(pop)
-
 #endif // KIT_PROTOCOL_INTERPRETER_H
\ No newline at end of file
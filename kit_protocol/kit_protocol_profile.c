@@ -0,0 +1,552 @@
+/**
+ * \file
+ *
+ * \brief  KIT protocol HAL timing
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L   // clock_gettime of the cycle counter, also with -std=c99
+#endif
+
+#include <string.h>
+#include "kitprotocol_parser_config.h"
+#include "kit_protocol_api.h"
+#include "kit_protocol_profile.h"
+
+#ifdef KIT_HAL_PROFILE
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+#if KIT_PROFILE_BUCKETS > 32
+#error KIT_PROFILE_BUCKETS must be up to 32, the board:profile bucket mask
+#endif
+
+#define KIT_PROFILE_HEADER_SIZE     (5)     //! The size of the board:profile response header
+#define KIT_PROFILE_ENTRY_SIZE      (31)    //! The size of a board:profile histogram, without its bucket counts
+#define KIT_PROFILE_RESPONSE_MAX    ((KIT_MESSAGE_SIZE_MAX - 8) / 2)  //! The board:profile response fits its ASCII hex
+
+// The device histograms start with the wake, the init and discover calls are not for a device
+#define KIT_PROFILE_DEVICE_OPERATIONS  (KIT_PROFILE_OPERATIONS - KIT_PROFILE_WAKE)
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define KIT_PROFILE_DEMCR           (*(volatile uint32_t *)0xE000EDFC)  //! Debug Exception and Monitor Control
+#define KIT_PROFILE_DWT_CTRL        (*(volatile uint32_t *)0xE0001000)  //! DWT Control
+#define KIT_PROFILE_DWT_CYCCNT      (*(volatile uint32_t *)0xE0001004)  //! DWT Cycle Count
+#define KIT_PROFILE_DEMCR_TRCENA    (1UL << 24)
+#define KIT_PROFILE_DWT_CYCCNTENA   (1UL << 0)
+#endif
+
+static kit_trace_clock_t g_kit_profile_clock;
+static uint32_t g_kit_profile_clock_rate;
+static struct kit_profile_histogram g_kit_profile_bus[KIT_PROFILE_BUSES][KIT_PROFILE_OPERATIONS];
+static struct kit_profile_histogram g_kit_profile_device[MAX_DISCOVER_DEVICES][KIT_PROFILE_DEVICE_OPERATIONS];
+// The HAL called by the shim of each bus
+static const struct kit_hal_interface *g_kit_profile_hal[KIT_PROFILE_BUSES];
+
+#ifdef KIT_PROFILE_CYCLE_COUNTER
+uint32_t kit_profile_cycle_counter(void)
+{
+#if defined(__linux__)
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)(((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec);
+#else
+    return KIT_PROFILE_DWT_CYCCNT;
+#endif
+}
+#endif // KIT_PROFILE_CYCLE_COUNTER
+
+void kit_profile_start(kit_trace_clock_t clock, uint32_t clock_rate)
+{
+#if defined(KIT_PROFILE_DWT_CYCCNT)
+    if (clock == kit_profile_cycle_counter)
+    {
+        KIT_PROFILE_DEMCR |= KIT_PROFILE_DEMCR_TRCENA;
+        KIT_PROFILE_DWT_CTRL |= KIT_PROFILE_DWT_CYCCNTENA;
+    }
+#endif
+
+    g_kit_profile_clock_rate = clock_rate;
+    g_kit_profile_clock = (clock_rate != 0) ? clock : NULL;
+}
+
+void kit_profile_stop(void)
+{
+    g_kit_profile_clock = NULL;
+}
+
+void kit_profile_clear(void)
+{
+    memset(g_kit_profile_bus, 0, sizeof(g_kit_profile_bus));
+    memset(g_kit_profile_device, 0, sizeof(g_kit_profile_device));
+}
+
+uint32_t kit_profile_get_clock_rate(void)
+{
+    return g_kit_profile_clock_rate;
+}
+
+const struct kit_profile_histogram *kit_profile_get_bus_histogram(interface_id_t bus_type,
+                                                                  enum kit_profile_operation operation)
+{
+    if ((bus_type == DEVKIT_IF_UNKNOWN) || (bus_type > KIT_PROFILE_BUSES) || (operation >= KIT_PROFILE_OPERATIONS))
+    {
+        return NULL;
+    }
+
+    return &g_kit_profile_bus[bus_type - 1][operation];
+}
+
+const struct kit_profile_histogram *kit_profile_get_device_histogram(uint8_t device_index,
+                                                                     enum kit_profile_operation operation)
+{
+    if ((device_index >= MAX_DISCOVER_DEVICES) || (operation < KIT_PROFILE_WAKE) || (operation >= KIT_PROFILE_OPERATIONS))
+    {
+        return NULL;
+    }
+
+    return &g_kit_profile_device[device_index][operation - KIT_PROFILE_WAKE];
+}
+
+/** \brief Adds a call to a histogram.
+ *
+ *  \param[in]    ticks                  The duration of the call, in clock ticks
+ *                bucket                 The duration bucket of the call
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] histogram              The histogram
+ *
+ *  \return None
+ */
+static void kit_profile_add(struct kit_profile_histogram *histogram, uint32_t ticks, uint8_t bucket)
+{
+    if ((histogram->count == 0) || (ticks < histogram->min))
+    {
+        histogram->min = ticks;
+    }
+    if (ticks > histogram->max)
+    {
+        histogram->max = ticks;
+    }
+
+    histogram->count++;
+    histogram->total += ticks;
+    histogram->buckets[bucket]++;
+}
+
+/** \brief Records a HAL call in the histograms of its bus and of its device.
+ *
+ *  \param[in]    bus_type               The bus of the call
+ *                address                The device address of the call, unused for init
+ *                                       and discover
+ *                operation              The HAL operation
+ *                start                  The clock time at the start of the call
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void kit_profile_record(interface_id_t bus_type, uint32_t address, enum kit_profile_operation operation,
+                               uint32_t start)
+{
+    const uint32_t ticks = g_kit_profile_clock() - start;
+    const uint64_t duration_us = ((uint64_t)ticks * 1000000ULL) / g_kit_profile_clock_rate;
+    const device_info_t *device;
+    uint8_t bucket = 0;
+
+    // The log2 bucket of the duration, 0 under a microsecond
+    while ((bucket < (KIT_PROFILE_BUCKETS - 1)) && ((duration_us >> bucket) != 0))
+    {
+        bucket++;
+    }
+
+    kit_profile_add(&g_kit_profile_bus[bus_type - 1][operation], ticks, bucket);
+
+    if (operation < KIT_PROFILE_WAKE)
+    {
+        return;
+    }
+
+    device = get_device_info_by_address(address, bus_type);
+    if (device != NULL)
+    {
+        kit_profile_add(&g_kit_profile_device[device - get_device_info(0)][operation - KIT_PROFILE_WAKE], ticks, bucket);
+    }
+}
+
+/** \brief Returns the clock time at the start of a HAL call.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The clock time, 0 when stopped
+ */
+static uint32_t kit_profile_now(void)
+{
+    return (g_kit_profile_clock != NULL) ? g_kit_profile_clock() : 0;
+}
+
+static void kit_profile_init(interface_id_t bus_type)
+{
+    const uint32_t start = kit_profile_now();
+
+    g_kit_profile_hal[bus_type - 1]->init();
+    if (g_kit_profile_clock != NULL)
+    {
+        kit_profile_record(bus_type, 0, KIT_PROFILE_INIT, start);
+    }
+}
+
+static void kit_profile_discover(interface_id_t bus_type, device_info_t *device_info, uint8_t *device_count)
+{
+    const uint32_t start = kit_profile_now();
+
+    g_kit_profile_hal[bus_type - 1]->discover(device_info, device_count);
+    if (g_kit_profile_clock != NULL)
+    {
+        kit_profile_record(bus_type, 0, KIT_PROFILE_DISCOVER, start);
+    }
+}
+
+static enum kit_protocol_status kit_profile_token(interface_id_t bus_type, enum kit_profile_operation operation,
+                                                  enum kit_protocol_status (*token)(uint32_t), uint32_t address)
+{
+    const uint32_t start = kit_profile_now();
+    const enum kit_protocol_status status = token(address);
+
+    if (g_kit_profile_clock != NULL)
+    {
+        kit_profile_record(bus_type, address, operation, start);
+    }
+
+    return status;
+}
+
+static enum kit_protocol_status kit_profile_transfer(interface_id_t bus_type, enum kit_profile_operation operation,
+                                                     enum kit_protocol_status (*transfer)(uint32_t, uint8_t *, uint16_t *),
+                                                     uint32_t address, uint8_t *message, uint16_t *length)
+{
+    const uint32_t start = kit_profile_now();
+    const enum kit_protocol_status status = transfer(address, message, length);
+
+    if (g_kit_profile_clock != NULL)
+    {
+        kit_profile_record(bus_type, address, operation, start);
+    }
+
+    return status;
+}
+
+#ifdef KIT_HAL_TALK_ASYNC
+#define KIT_PROFILE_TALK_ASYNC(prefix, bus)                                                                                    \
+    static enum kit_protocol_status kit_profile_##prefix##_talk_start(uint32_t address, uint8_t *message, uint16_t *length)    \
+    {                                                                                                                          \
+        return kit_profile_transfer(bus, KIT_PROFILE_SEND, g_kit_profile_hal[bus - 1]->talk_start, address,                    \
+                                    message, length);                                                                          \
+    }                                                                                                                          \
+    static enum kit_protocol_status kit_profile_##prefix##_talk_complete(uint32_t address, uint8_t *message, uint16_t *length) \
+    {                                                                                                                          \
+        return kit_profile_transfer(bus, KIT_PROFILE_RECEIVE, g_kit_profile_hal[bus - 1]->talk_complete,                       \
+                                    address, message, length);                                                                 \
+    }
+#define KIT_PROFILE_TALK_ASYNC_HAL(prefix)                                                                                     \
+    .talk_start = &kit_profile_##prefix##_talk_start,                                                                          \
+    .talk_complete = &kit_profile_##prefix##_talk_complete,
+#else
+#define KIT_PROFILE_TALK_ASYNC(prefix, bus)
+#define KIT_PROFILE_TALK_ASYNC_HAL(prefix)
+#endif // KIT_HAL_TALK_ASYNC
+
+// The timing shim of a bus, each function times the call of the bus HAL
+#define KIT_PROFILE_BUS(prefix, bus)                                                                                           \
+    static void kit_profile_##prefix##_init(void)                                                                              \
+    {                                                                                                                          \
+        kit_profile_init(bus);                                                                                                 \
+    }                                                                                                                          \
+    static void kit_profile_##prefix##_deinit(void)                                                                            \
+    {                                                                                                                          \
+        g_kit_profile_hal[bus - 1]->deinit();                                                                                  \
+    }                                                                                                                          \
+    static void kit_profile_##prefix##_discover(device_info_t *device_info, uint8_t *device_count)                             \
+    {                                                                                                                          \
+        kit_profile_discover(bus, device_info, device_count);                                                                  \
+    }                                                                                                                          \
+    static enum kit_protocol_status kit_profile_##prefix##_wake(uint32_t address)                                              \
+    {                                                                                                                          \
+        return kit_profile_token(bus, KIT_PROFILE_WAKE, g_kit_profile_hal[bus - 1]->wake, address);                            \
+    }                                                                                                                          \
+    static enum kit_protocol_status kit_profile_##prefix##_sleep(uint32_t address)                                             \
+    {                                                                                                                          \
+        return kit_profile_token(bus, KIT_PROFILE_SLEEP, g_kit_profile_hal[bus - 1]->sleep, address);                          \
+    }                                                                                                                          \
+    static enum kit_protocol_status kit_profile_##prefix##_idle(uint32_t address)                                              \
+    {                                                                                                                          \
+        return kit_profile_token(bus, KIT_PROFILE_IDLE, g_kit_profile_hal[bus - 1]->idle, address);                            \
+    }                                                                                                                          \
+    static enum kit_protocol_status kit_profile_##prefix##_send(uint32_t address, uint8_t *message, uint16_t *length)          \
+    {                                                                                                                          \
+        return kit_profile_transfer(bus, KIT_PROFILE_SEND, g_kit_profile_hal[bus - 1]->send, address, message,                 \
+                                    length);                                                                                   \
+    }                                                                                                                          \
+    static enum kit_protocol_status kit_profile_##prefix##_receive(uint32_t address, uint8_t *message, uint16_t *length)       \
+    {                                                                                                                          \
+        return kit_profile_transfer(bus, KIT_PROFILE_RECEIVE, g_kit_profile_hal[bus - 1]->receive, address,                    \
+                                    message, length);                                                                          \
+    }                                                                                                                          \
+    static enum kit_protocol_status kit_profile_##prefix##_talk(uint32_t address, uint8_t *message, uint16_t *length)          \
+    {                                                                                                                          \
+        return kit_profile_transfer(bus, KIT_PROFILE_TALK, g_kit_profile_hal[bus - 1]->talk, address, message,                 \
+                                    length);                                                                                   \
+    }                                                                                                                          \
+    KIT_PROFILE_TALK_ASYNC(prefix, bus)                                                                                        \
+    static const struct kit_hal_interface g_kit_profile_##prefix =                                                             \
+    {                                                                                                                          \
+        .init = &kit_profile_##prefix##_init,                                                                                  \
+        .deinit = &kit_profile_##prefix##_deinit,                                                                              \
+        .discover = &kit_profile_##prefix##_discover,                                                                          \
+        .wake = &kit_profile_##prefix##_wake,                                                                                  \
+        .sleep = &kit_profile_##prefix##_sleep,                                                                                \
+        .idle = &kit_profile_##prefix##_idle,                                                                                  \
+        .send = &kit_profile_##prefix##_send,                                                                                  \
+        .receive = &kit_profile_##prefix##_receive,                                                                            \
+        .talk = &kit_profile_##prefix##_talk,                                                                                  \
+        KIT_PROFILE_TALK_ASYNC_HAL(prefix)                                                                                     \
+    };
+
+#ifdef KIT_HAL_I2C
+KIT_PROFILE_BUS(i2c, DEVKIT_IF_I2C)
+#endif
+
+#ifdef KIT_HAL_SWI
+KIT_PROFILE_BUS(swi, DEVKIT_IF_SWI)
+#endif
+
+#ifdef KIT_HAL_SPI
+KIT_PROFILE_BUS(spi, DEVKIT_IF_SPI)
+#endif
+
+#ifdef KIT_HAL_SWI2
+KIT_PROFILE_BUS(gpio, DEVKIT_IF_SWI2)
+#endif
+
+const struct kit_hal_interface *kit_profile_wrap_hal(interface_id_t bus_type, const struct kit_hal_interface *hal)
+{
+    const struct kit_hal_interface *shim = NULL;
+
+    switch (bus_type)
+    {
+    case DEVKIT_IF_I2C:
+#ifdef KIT_HAL_I2C
+        shim = &g_kit_profile_i2c;
+#endif
+        break;
+
+    case DEVKIT_IF_SWI:
+#ifdef KIT_HAL_SWI
+        shim = &g_kit_profile_swi;
+#endif
+        break;
+
+    case DEVKIT_IF_SPI:
+#ifdef KIT_HAL_SPI
+        shim = &g_kit_profile_spi;
+#endif
+        break;
+
+    case DEVKIT_IF_SWI2:
+#ifdef KIT_HAL_SWI2
+        shim = &g_kit_profile_gpio;
+#endif
+        break;
+
+    default:
+        break;
+    }
+
+    if ((shim == NULL) || (hal == NULL))
+    {
+        return hal;
+    }
+
+    g_kit_profile_hal[bus_type - 1] = hal;
+
+    return shim;
+}
+
+/** \brief Writes a big endian value in the board:profile response.
+ *
+ *  \param[in]    value                  The value
+ *                size                   The number of bytes of the value
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] message                The response
+ *                length                 As input, the offset of the value
+ *                                       As output, the offset after the value
+ *
+ *  \return None
+ */
+static void kit_profile_put(uint64_t value, uint8_t size, uint8_t *message, uint16_t *length)
+{
+    while (size-- != 0)
+    {
+        message[(*length)++] = (uint8_t)(value >> (size * 8));
+    }
+}
+
+/** \brief Writes a histogram in the board:profile response, nothing when it has
+ *         no calls.
+ *
+ *  \param[in]    histogram              The histogram
+ *                bus_type               The bus of the histogram
+ *                device_index           The device index of the histogram, KIT_PROFILE_BUS_INDEX
+ *                                       for a bus histogram
+ *                operation              The HAL operation of the histogram
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] message                The response
+ *                length                 As input, the size of the response
+ *                                       As output, the size of the response with the histogram
+ *
+ *  \return KIT_STATUS_SUCCESS on success, KIT_STATUS_SMALL_BUFFER when it does not fit
+ */
+static enum kit_protocol_status kit_profile_put_histogram(const struct kit_profile_histogram *histogram,
+                                                          uint8_t bus_type, uint8_t device_index,
+                                                          enum kit_profile_operation operation,
+                                                          uint8_t *message, uint16_t *length)
+{
+    uint32_t mask = 0;
+    uint16_t size = KIT_PROFILE_ENTRY_SIZE;
+    uint8_t bucket;
+
+    if (histogram->count == 0)
+    {
+        return KIT_STATUS_SUCCESS;
+    }
+
+    for (bucket = 0; bucket < KIT_PROFILE_BUCKETS; bucket++)
+    {
+        if (histogram->buckets[bucket] != 0)
+        {
+            mask |= (1UL << bucket);
+            size += sizeof(histogram->buckets[bucket]);
+        }
+    }
+
+    if ((*length + size) > KIT_PROFILE_RESPONSE_MAX)
+    {
+        return KIT_STATUS_SMALL_BUFFER;
+    }
+
+    kit_profile_put(bus_type, 1, message, length);
+    kit_profile_put(device_index, 1, message, length);
+    kit_profile_put(operation, 1, message, length);
+    kit_profile_put(histogram->count, 4, message, length);
+    kit_profile_put(histogram->total, 8, message, length);
+    kit_profile_put(histogram->min, 4, message, length);
+    kit_profile_put(histogram->max, 4, message, length);
+    kit_profile_put(mask, 4, message, length);
+    for (bucket = 0; bucket < KIT_PROFILE_BUCKETS; bucket++)
+    {
+        if (histogram->buckets[bucket] != 0)
+        {
+            kit_profile_put(histogram->buckets[bucket], 4, message, length);
+        }
+    }
+
+    return KIT_STATUS_SUCCESS;
+}
+
+enum kit_protocol_status kit_board_profile(uint8_t *message, uint16_t *message_length)
+{
+    enum kit_protocol_status status = KIT_STATUS_SUCCESS;
+    const device_info_t *device = NULL;
+    uint8_t device_index = KIT_PROFILE_BUS_INDEX;
+    uint16_t length = 0;
+    uint8_t bus_type;
+    uint8_t operation;
+
+    if (*message_length != 0)
+    {
+        if (message[0] == KIT_PROFILE_CLEAR)
+        {
+            kit_profile_clear();
+            *message_length = 0;
+            return KIT_STATUS_SUCCESS;
+        }
+
+        device_index = message[0];
+        device = get_device_info(device_index);
+        if ((device == NULL) || (device->bus_type == DEVKIT_IF_UNKNOWN))
+        {
+            *message_length = 0;
+            return KIT_STATUS_NO_DEVICE;
+        }
+    }
+
+    kit_profile_put(g_kit_profile_clock_rate, 4, message, &length);
+    kit_profile_put(KIT_PROFILE_BUCKETS, 1, message, &length);
+
+    if (device != NULL)
+    {
+        for (operation = KIT_PROFILE_WAKE; (operation < KIT_PROFILE_OPERATIONS) && (status == KIT_STATUS_SUCCESS); operation++)
+        {
+            status = kit_profile_put_histogram(kit_profile_get_device_histogram(device_index, operation),
+                                               device->bus_type, device_index, operation, message, &length);
+        }
+    }
+    else
+    {
+        for (bus_type = DEVKIT_IF_SPI; (bus_type <= KIT_PROFILE_BUSES) && (status == KIT_STATUS_SUCCESS); bus_type++)
+        {
+            for (operation = 0; (operation < KIT_PROFILE_OPERATIONS) && (status == KIT_STATUS_SUCCESS); operation++)
+            {
+                status = kit_profile_put_histogram(kit_profile_get_bus_histogram(bus_type, operation),
+                                                   bus_type, KIT_PROFILE_BUS_INDEX, operation, message, &length);
+            }
+        }
+    }
+
+    *message_length = length;
+
+    return status;
+}
+
+#endif // KIT_HAL_PROFILE
@@ -0,0 +1,225 @@
+/**
+ * \file
+ *
+ * \brief  KIT protocol HAL timing
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#ifndef KIT_PROTOCOL_PROFILE_H
+#define KIT_PROTOCOL_PROFILE_H
+
+#include <stdint.h>
+#include "kit_hal_interface.h"
+#include "kit_protocol_trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#ifndef KIT_PROFILE_BUCKETS
+#define KIT_PROFILE_BUCKETS         (20)    //! The number of log2 microsecond buckets of a histogram, up to 32
+#endif // KIT_PROFILE_BUCKETS
+
+#define KIT_PROFILE_BUSES           (DEVKIT_IF_SWI2)  //! The profiled buses, from DEVKIT_IF_SPI to DEVKIT_IF_SWI2
+#define KIT_PROFILE_CLEAR           (0xFF)  //! The board:profile data byte which clears the histograms
+#define KIT_PROFILE_BUS_INDEX       (0xFF)  //! The device index of the bus histograms in the board:profile response
+
+// The free running cycle counter of the platform, when it has one
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__) || defined(__linux__)
+#define KIT_PROFILE_CYCLE_COUNTER
+#endif
+
+/**
+ * \brief The profiled HAL operations.
+ */
+enum kit_profile_operation
+{
+    KIT_PROFILE_INIT = 0,           //!< hal init, bus histogram only
+    KIT_PROFILE_DISCOVER,           //!< hal discover, bus histogram only
+    KIT_PROFILE_WAKE,               //!< hal wake
+    KIT_PROFILE_IDLE,               //!< hal idle
+    KIT_PROFILE_SLEEP,              //!< hal sleep
+    KIT_PROFILE_SEND,               //!< hal send and talk_start
+    KIT_PROFILE_RECEIVE,            //!< hal receive and talk_complete
+    KIT_PROFILE_TALK,               //!< hal talk
+
+    KIT_PROFILE_OPERATIONS
+};
+
+/**
+ * \brief The durations of a HAL operation. The bucket 0 counts the calls under 1 us,
+ *        the bucket n the calls from 2^(n-1) us up to 2^n us and the last bucket all
+ *        the longer ones.
+ */
+struct kit_profile_histogram
+{
+    uint32_t count;                           //!< The number of calls
+    uint32_t min;                             //!< The shortest call, in clock ticks
+    uint32_t max;                             //!< The longest call, in clock ticks
+    uint64_t total;                           //!< The duration of all the calls, in clock ticks
+    uint32_t buckets[KIT_PROFILE_BUCKETS];    //!< The number of calls of each duration bucket
+};
+
+/** \brief Starts timing the HAL calls. The histograms keep their counts, see
+ *         kit_profile_clear.
+ *
+ *  \note  Only the HAL returned by get_hal_interface is timed, it is started before
+ *         hardware_interface_discover to time the bus initialization and discovery.
+ *
+ *  \param[in]    clock                  The free running clock of the durations (Ex.
+ *                                       kit_profile_cycle_counter)
+ *                clock_rate             The number of clock ticks per second
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_profile_start(kit_trace_clock_t clock, uint32_t clock_rate);
+
+/** \brief Stops timing the HAL calls, the HAL is still called through the shim.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_profile_stop(void);
+
+/** \brief Clears all the histograms.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_profile_clear(void);
+
+/** \brief Returns the rate of the clock given to kit_profile_start.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The number of clock ticks per second, 0 when never started
+ */
+uint32_t kit_profile_get_clock_rate(void);
+
+/** \brief Returns the HAL timing shim of a bus, its functions time the calls and
+ *         call the bus HAL. It is used by get_hal_interface.
+ *
+ *  \param[in]    bus_type               The bus of the HAL
+ *                hal                    The HAL of the bus
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the timing shim, hal itself when the bus is not profiled
+ */
+const struct kit_hal_interface *kit_profile_wrap_hal(interface_id_t bus_type, const struct kit_hal_interface *hal);
+
+/** \brief Returns the histogram of an operation on a bus, all its devices included.
+ *
+ *  \param[in]    bus_type               The bus
+ *                operation              The HAL operation
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the histogram, NULL for an unknown bus or operation
+ */
+const struct kit_profile_histogram *kit_profile_get_bus_histogram(interface_id_t bus_type,
+                                                                  enum kit_profile_operation operation);
+
+/** \brief Returns the histogram of an operation on a discovered device.
+ *
+ *  \param[in]    device_index           The board:device index of the device
+ *                operation              The HAL operation, from KIT_PROFILE_WAKE
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the histogram, NULL for an unknown device or operation
+ */
+const struct kit_profile_histogram *kit_profile_get_device_histogram(uint8_t device_index,
+                                                                     enum kit_profile_operation operation);
+
+/** \brief Dumps or clears the HAL timing histograms, for board:profile.
+ *
+ *  \note  The response is <clock rate:4><buckets:1> followed by
+ *         <bus><device index><operation><count:4><total:8><min:4><max:4><bucket mask:4>
+ *         and the count of each bucket of the mask, for each histogram with calls,
+ *         big endian. The device index of the bus histograms is FF.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] message                As input, nothing for the bus histograms, a device
+ *                                       index for its histograms or FF to clear them all
+ *                                       As output, references to the histograms
+ *                message_length         As input, references to size of message (number of bytes)
+ *                                       As output, references to size of the histograms
+ *
+ *  \return KIT_STATUS_SUCCESS on success, KIT_STATUS_NO_DEVICE for an unknown device,
+ *          otherwise an error code
+ */
+enum kit_protocol_status kit_board_profile(uint8_t *message, uint16_t *message_length);
+
+#ifdef KIT_PROFILE_CYCLE_COUNTER
+/** \brief Returns the cycle counter: the DWT cycle counter on Cortex-M (enabled by
+ *         kit_profile_start), the CLOCK_MONOTONIC nanoseconds on Linux.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The cycle counter
+ */
+uint32_t kit_profile_cycle_counter(void);
+#endif // KIT_PROFILE_CYCLE_COUNTER
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // KIT_PROTOCOL_PROFILE_H
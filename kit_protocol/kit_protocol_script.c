@@ -0,0 +1,226 @@
+/**
+ * \file
+ *
+ * \brief  KIT protocol command script engine
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#include <string.h>
+#include "kitprotocol_parser_config.h"
+#include "kit_hal_interface.h"
+#include "kit_protocol_init.h"
+#include "kit_protocol_script.h"
+#include "utilities/crc/crc_engines.h"
+
+#ifdef KIT_PROTOCOL_SCRIPT
+
+#ifndef KIT_SCRIPT_PACKET_SIZE
+#define KIT_SCRIPT_PACKET_SIZE  (256)  //! The size of the script packet and response buffers
+#endif // KIT_SCRIPT_PACKET_SIZE
+
+#if (KIT_SCRIPT_PACKET_SIZE < 256)
+#error KIT_SCRIPT_PACKET_SIZE does not fit an ECC device response
+#endif
+
+#define KIT_SCRIPT_CRC_SIZE     (2)    //! The size of the ECC framing CRC
+
+// The device packet built by the script, and the last device response
+static uint8_t g_kit_script_packet[KIT_SCRIPT_PACKET_SIZE];
+static uint8_t g_kit_script_response[KIT_SCRIPT_PACKET_SIZE];
+
+/** \brief Returns the size of a script instruction.
+ *
+ *  \param[in]    script                 The script
+ *                offset                 The offset of the instruction in the script
+ *                length                 The length of the script
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The size of the instruction, 0 when it is unknown or truncated
+ */
+static uint16_t kit_script_instruction_size(const uint8_t *script, uint16_t offset, uint16_t length)
+{
+    const uint16_t remaining = (uint16_t)(length - offset);
+    uint16_t size;
+
+    switch (script[offset])
+    {
+    case KIT_SCRIPT_END:
+    case KIT_SCRIPT_WAKE:
+    case KIT_SCRIPT_IDLE:
+    case KIT_SCRIPT_SLEEP:
+    case KIT_SCRIPT_CRC:
+    case KIT_SCRIPT_TALK:
+        size = 1;
+        break;
+    case KIT_SCRIPT_LOAD:
+        size = 3;
+        if (remaining >= size)
+        {
+            size = (uint16_t)(size + ((script[offset + 1] << 8) | script[offset + 2]));
+        }
+        break;
+    case KIT_SCRIPT_COPY:
+        size = 4;
+        break;
+    case KIT_SCRIPT_EXPECT:
+        size = 3;
+        break;
+    default:
+        return 0;
+    }
+
+    return (size <= remaining) ? size : 0;
+}
+
+/** \brief Checks a script: every instruction is known, complete, and every
+ *         loaded packet fits the packet buffer.
+ *
+ *  \param[in]    script                 The script
+ *                length                 The length of the script
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS when the script can run, otherwise KIT_STATUS_INVALID_PARAM
+ */
+static enum kit_protocol_status kit_script_check(const uint8_t *script, uint16_t length)
+{
+    uint16_t offset = 0;
+    uint16_t size;
+
+    while ((offset < length) && (script[offset] != KIT_SCRIPT_END))
+    {
+        size = kit_script_instruction_size(script, offset, length);
+        if ((size == 0) || ((script[offset] == KIT_SCRIPT_LOAD) && ((size - 3) > KIT_SCRIPT_PACKET_SIZE)))
+        {
+            return KIT_STATUS_INVALID_PARAM;
+        }
+        offset = (uint16_t)(offset + size);
+    }
+
+    return KIT_STATUS_SUCCESS;
+}
+
+enum kit_protocol_status kit_script_run(uint32_t device_id, uint8_t *message, uint16_t *message_length)
+{
+    enum kit_protocol_status status;
+    const uint16_t length = *message_length;
+    uint16_t packet_length = 0;
+    uint16_t response_length = 0;
+    uint16_t offset = 0;
+    uint8_t wake_response[4];
+    uint16_t wake_length;
+    const uint8_t *operand;
+    const device_info_t *device = get_device_info_by_address(device_id, DEVKIT_IF_UNKNOWN);
+
+    status = kit_script_check(message, length);
+
+    // The response buffer fits the count byte framed responses, not the TA10x ones
+    if ((status == KIT_STATUS_SUCCESS) && (device != NULL) && check_ta_device(device->device_type))
+    {
+        status = KIT_STATUS_COMMAND_NOT_SUPPORTED;
+    }
+
+    while ((status == KIT_STATUS_SUCCESS) && (offset < length) && (message[offset] != KIT_SCRIPT_END))
+    {
+        operand = &message[offset + 1];
+
+        switch (message[offset])
+        {
+        case KIT_SCRIPT_WAKE:
+            wake_length = sizeof(wake_response);
+            status = kit_device_wake(device_id, wake_response, &wake_length);
+            break;
+        case KIT_SCRIPT_IDLE:
+            status = kit_device_idle(device_id);
+            break;
+        case KIT_SCRIPT_SLEEP:
+            status = kit_device_sleep(device_id);
+            break;
+        case KIT_SCRIPT_LOAD:
+            packet_length = (uint16_t)((operand[0] << 8) | operand[1]);
+            memcpy(g_kit_script_packet, &operand[2], packet_length);
+            break;
+        case KIT_SCRIPT_COPY:
+            // The copied field is carried from the last response into the next command
+            if (((operand[0] + operand[2]) > response_length) || ((operand[1] + operand[2]) > packet_length))
+            {
+                status = KIT_STATUS_INVALID_PARAM;
+                break;
+            }
+            memcpy(&g_kit_script_packet[operand[1]], &g_kit_script_response[operand[0]], operand[2]);
+            break;
+        case KIT_SCRIPT_CRC:
+            if ((g_kit_script_packet[0] < (KIT_SCRIPT_CRC_SIZE + 1)) || (g_kit_script_packet[0] > packet_length))
+            {
+                status = KIT_STATUS_INVALID_PARAM;
+                break;
+            }
+            calculate_sha_ecc_crc((uint8_t)(g_kit_script_packet[0] - KIT_SCRIPT_CRC_SIZE), g_kit_script_packet,
+                                  &g_kit_script_packet[g_kit_script_packet[0] - KIT_SCRIPT_CRC_SIZE]);
+            break;
+        case KIT_SCRIPT_TALK:
+            // The packet stays loaded, it can be sent again
+            memcpy(g_kit_script_response, g_kit_script_packet, packet_length);
+            response_length = packet_length;
+            status = kit_device_talk(device_id, g_kit_script_response, &response_length);
+            if (status != KIT_STATUS_SUCCESS)
+            {
+                response_length = 0;
+            }
+            break;
+        case KIT_SCRIPT_EXPECT:
+            if ((operand[0] >= response_length) || (g_kit_script_response[operand[0]] != operand[1]))
+            {
+                status = KIT_STATUS_EXECUTION_ERROR;
+            }
+            break;
+        default:
+            break;
+        }
+
+        if (status == KIT_STATUS_SUCCESS)
+        {
+            offset = (uint16_t)(offset + kit_script_instruction_size(message, offset, length));
+        }
+    }
+
+    // The script is replaced by its response, led by where the script stopped
+    message[0] = (uint8_t)(offset >> 8);
+    message[1] = (uint8_t)offset;
+    memcpy(&message[2], g_kit_script_response, response_length);
+    *message_length = (uint16_t)(response_length + 2);
+
+    return status;
+}
+
+#endif // KIT_PROTOCOL_SCRIPT
@@ -0,0 +1,91 @@
+/**
+ * \file
+ *
+ * \brief  KIT protocol command script engine
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#ifndef KIT_PROTOCOL_SCRIPT_H
+#define KIT_PROTOCOL_SCRIPT_H
+
+#include <stdint.h>
+#include "kit_protocol_status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/**
+ * \brief The instructions of a board:script bytecode script.
+ *
+ * A script runs on the selected device one instruction after the other. It
+ * builds a device packet with LOAD and COPY, sends it with TALK and checks the
+ * response with EXPECT. The script ends at its last byte or at END, and it is
+ * aborted by the first failed instruction.
+ */
+enum kit_script_opcode
+{
+    KIT_SCRIPT_END    = 0x00,  //!< Ends the script
+    KIT_SCRIPT_WAKE   = 0x01,  //!< Wakes the device
+    KIT_SCRIPT_IDLE   = 0x02,  //!< Sends the idle token
+    KIT_SCRIPT_SLEEP  = 0x03,  //!< Sends the sleep token
+    KIT_SCRIPT_LOAD   = 0x04,  //!< <length:2><packet> Loads the device packet
+    KIT_SCRIPT_COPY   = 0x05,  //!< <response offset><packet offset><count> Copies response bytes into the packet
+    KIT_SCRIPT_CRC    = 0x06,  //!< Updates the CRC of the packet (ECC framing, the count byte first)
+    KIT_SCRIPT_TALK   = 0x07,  //!< Sends the packet, its response replaces the previous one
+    KIT_SCRIPT_EXPECT = 0x08   //!< <offset><value> Aborts unless the response byte has the value
+};
+
+/** \brief Runs a board:script bytecode script on a device.
+ *
+ *  \note  The whole script is checked before the first instruction runs, so a
+ *         malformed script sends nothing to the device. The scripts run on the
+ *         ECC devices, a TA10x response does not fit the script response buffer.
+ *
+ *  \param[in]    device_id              The device address
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] message                As input, the script
+ *                                       As output, <offset:2> of the instruction which
+ *                                       ended the script, followed by the last device response
+ *                message_length         As input, references to size of the script
+ *                                       As output, references to size of the response
+ *
+ *  \return KIT_STATUS_SUCCESS on success, KIT_STATUS_INVALID_PARAM for a malformed
+ *          script, KIT_STATUS_COMMAND_NOT_SUPPORTED on a TA10x device,
+ *          KIT_STATUS_EXECUTION_ERROR when an EXPECT failed, otherwise the
+ *          status of the failed device step
+ */
+enum kit_protocol_status kit_script_run(uint32_t device_id, uint8_t *message, uint16_t *message_length);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // KIT_PROTOCOL_SCRIPT_H
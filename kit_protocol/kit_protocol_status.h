@@ -62,6 +62,7 @@ enum kit_protocol_status
 {
     KIT_STATUS_SUCCESS               = 0x00,
     KIT_STATUS_FAILURE               = 0x01,
+    KIT_STATUS_PENDING               = 0x02,
     KIT_STATUS_COMMAND_NOT_VALID     = 0x03,
     KIT_STATUS_COMMAND_NOT_SUPPORTED = 0x04,
     KIT_STATUS_NO_DEVICE             = 0xC5,
@@ -0,0 +1,360 @@
+/**
+ * \file
+ *
+ * \brief  KIT protocol deferred traffic trace
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L   // nanosleep of the Linux drain thread, also with -std=c99
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "kitprotocol_parser_config.h"
+#include "kit_protocol_api.h"
+#include "kit_protocol_trace.h"
+
+#ifdef KIT_TRACE_DRAIN_THREAD
+#include <pthread.h>
+#include <time.h>
+#endif // KIT_TRACE_DRAIN_THREAD
+
+#if defined(KIT_TRACE_DRAIN_THREAD) && !defined(KIT_PROTOCOL_TRACE)
+#error KIT_TRACE_DRAIN_THREAD drains the trace ring of KIT_PROTOCOL_TRACE
+#endif
+
+#ifdef KIT_PROTOCOL_TRACE
+
+#ifndef KIT_TRACE_RECORDS
+#define KIT_TRACE_RECORDS    (16)  //! The number of trace records, a power of 2
+#endif // KIT_TRACE_RECORDS
+
+#ifndef KIT_TRACE_DATA_SIZE
+#define KIT_TRACE_DATA_SIZE  (64)  //! The maximum number of traffic bytes copied in a trace record
+#endif // KIT_TRACE_DATA_SIZE
+
+#if (KIT_TRACE_RECORDS & (KIT_TRACE_RECORDS - 1)) || (KIT_TRACE_RECORDS > 32768)
+#error KIT_TRACE_RECORDS must be a power of 2, up to 32768
+#endif
+
+// The ring indexes are shared between the producer and the drain
+#if defined(__GNUC__)
+#define KIT_TRACE_LOAD(index)           __atomic_load_n(&(index), __ATOMIC_ACQUIRE)
+#define KIT_TRACE_STORE(index, value)   __atomic_store_n(&(index), (value), __ATOMIC_RELEASE)
+#else
+#define KIT_TRACE_LOAD(index)           (index)
+#define KIT_TRACE_STORE(index, value)   ((index) = (value))
+#endif
+
+struct kit_trace_record
+{
+    uint32_t timestamp;                  //!< The trace clock time
+    uint32_t device_id;                  //!< The device handle
+    uint16_t length;                     //!< The length of the traffic
+    uint16_t copied;                     //!< The number of traffic bytes copied in data
+    uint8_t direction;                   //!< The trace direction (enum kit_trace_direction)
+    uint8_t flags;                       //!< The KIT_TRACE_FLAG_ trace line flags
+    const char *text;                    //!< The text of the text records
+    uint8_t data[KIT_TRACE_DATA_SIZE];   //!< The traffic copy
+};
+
+#endif // KIT_PROTOCOL_TRACE
+
+static const char *g_kit_trace_header[] = {"Received", "Sent"};
+static kit_trace_clock_t g_kit_trace_clock;
+
+/** \brief Prints a trace line in the output console.
+ *
+ *  \param[in]    direction              The trace direction
+ *                flags                  The KIT_TRACE_FLAG_ trace line flags
+ *                timestamp              The trace clock time
+ *                text                   The text of the command records, NULL for none
+ *                data                   The traffic data
+ *                copied                 The number of traffic bytes in data
+ *                length                 The length of the traffic
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void kit_trace_print(uint8_t direction, uint8_t flags, uint32_t timestamp, const char *text,
+                            const uint8_t *data, uint16_t copied, uint16_t length)
+{
+    const uint8_t *delimiter;
+    int print_length = copied;
+    const char *line_end = "\r\n";
+
+    if (direction == KIT_TRACE_COMMAND)
+    {
+        // The command name completes the traffic line
+        if (text)
+        {
+            printf("........%s\r\n", text);
+        }
+        else
+        {
+            printf("%s", "\r\n");
+        }
+        return;
+    }
+
+    // Only the first message of the traffic is printed
+    delimiter = memchr(data, KIT_MESSAGE_DELIMITER, copied);
+    if (delimiter != NULL)
+    {
+        print_length = (int)(delimiter - data);
+    }
+
+    if (flags & KIT_TRACE_FLAG_SEPARATE)
+    {
+        line_end = "\r\n\n";
+    }
+    else if (flags & KIT_TRACE_FLAG_CONTINUED)
+    {
+        line_end = "";
+    }
+
+    if (g_kit_trace_clock != NULL)
+    {
+        printf("%lu ", (unsigned long)timestamp);
+    }
+
+    printf("%s: %.*s%s%s", g_kit_trace_header[direction], print_length, (const char *)data,
+           ((delimiter == NULL) && (length > copied)) ? "..." : "", line_end);
+}
+
+void kit_trace_set_clock(kit_trace_clock_t clock)
+{
+    g_kit_trace_clock = clock;
+}
+
+#ifdef KIT_PROTOCOL_TRACE
+
+static struct kit_trace_record g_kit_trace_records[KIT_TRACE_RECORDS];
+static volatile uint16_t g_kit_trace_head;     // Written by the producer only
+static volatile uint16_t g_kit_trace_tail;     // Written by the drain only
+static volatile uint32_t g_kit_trace_dropped;  // Written by the producer only
+static uint32_t g_kit_trace_dropped_reported;  // Used by the drain only
+
+/** \brief Reserves the next record of the trace ring.
+ *
+ *  \param[in]    direction              The trace direction
+ *                flags                  The KIT_TRACE_FLAG_ trace line flags
+ *                device_id              The device handle
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The record, NULL when the trace ring is full
+ */
+static struct kit_trace_record *kit_trace_reserve(enum kit_trace_direction direction, uint8_t flags, uint32_t device_id)
+{
+    const uint16_t head = g_kit_trace_head;
+    struct kit_trace_record *record;
+
+    if ((uint16_t)(head - KIT_TRACE_LOAD(g_kit_trace_tail)) >= KIT_TRACE_RECORDS)
+    {
+        // Never wait for the drain, count the record instead
+        g_kit_trace_dropped = g_kit_trace_dropped + 1;
+        return NULL;
+    }
+
+    record = &g_kit_trace_records[head & (KIT_TRACE_RECORDS - 1)];
+    record->timestamp = (g_kit_trace_clock != NULL) ? g_kit_trace_clock() : 0;
+    record->device_id = device_id;
+    record->direction = (uint8_t)direction;
+    record->flags = flags;
+    record->text = NULL;
+    record->length = 0;
+    record->copied = 0;
+
+    return record;
+}
+
+/** \brief Publishes the reserved record to the drain.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void kit_trace_commit(void)
+{
+    KIT_TRACE_STORE(g_kit_trace_head, (uint16_t)(g_kit_trace_head + 1));
+}
+
+bool kit_trace_record(enum kit_trace_direction direction, uint8_t flags, uint32_t device_id,
+                      const uint8_t *data, uint16_t length)
+{
+    struct kit_trace_record *record = kit_trace_reserve(direction, flags, device_id);
+
+    if (record == NULL)
+    {
+        return false;
+    }
+
+    record->length = length;
+    if (data != NULL)
+    {
+        record->copied = (length < KIT_TRACE_DATA_SIZE) ? length : KIT_TRACE_DATA_SIZE;
+        memcpy(record->data, data, record->copied);
+    }
+
+    kit_trace_commit();
+
+    return true;
+}
+
+bool kit_trace_record_text(enum kit_trace_direction direction, uint32_t device_id, const char *text)
+{
+    struct kit_trace_record *record = kit_trace_reserve(direction, 0, device_id);
+
+    if (record == NULL)
+    {
+        return false;
+    }
+
+    record->text = text;
+
+    kit_trace_commit();
+
+    return true;
+}
+
+uint16_t kit_trace_drain(uint16_t max_records)
+{
+    uint16_t tail = g_kit_trace_tail;
+    const uint16_t head = KIT_TRACE_LOAD(g_kit_trace_head);
+    const uint32_t dropped = g_kit_trace_dropped;
+    const struct kit_trace_record *record;
+    uint16_t count = 0;
+
+    while ((tail != head) && (count < max_records))
+    {
+        record = &g_kit_trace_records[tail & (KIT_TRACE_RECORDS - 1)];
+        kit_trace_print(record->direction, record->flags, record->timestamp, record->text,
+                        record->data, record->copied, record->length);
+        tail++;
+        count++;
+
+        // Release the record to the producer
+        KIT_TRACE_STORE(g_kit_trace_tail, tail);
+    }
+
+    if (dropped != g_kit_trace_dropped_reported)
+    {
+        printf("Trace: %lu records dropped\r\n", (unsigned long)(dropped - g_kit_trace_dropped_reported));
+        g_kit_trace_dropped_reported = dropped;
+    }
+
+    return count;
+}
+
+uint32_t kit_trace_get_dropped(void)
+{
+    return g_kit_trace_dropped;
+}
+
+#ifdef KIT_TRACE_DRAIN_THREAD
+/** \brief The drain thread, prints the trace records as they are recorded.
+ *
+ *  \param[in]    params                 Not used
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void *kit_trace_drain_thread(void *params)
+{
+    const struct timespec period = {0, 1000000};
+
+    (void)params;
+
+    for (;;)
+    {
+        if (kit_trace_drain(KIT_TRACE_RECORDS) == 0)
+        {
+            nanosleep(&period, NULL);
+        }
+    }
+
+    return NULL;
+}
+
+bool kit_trace_start_drain_thread(void)
+{
+    pthread_t thread;
+
+    if (pthread_create(&thread, NULL, &kit_trace_drain_thread, NULL) != 0)
+    {
+        return false;
+    }
+
+    return (pthread_detach(thread) == 0);
+}
+#endif // KIT_TRACE_DRAIN_THREAD
+
+#else
+
+bool kit_trace_record(enum kit_trace_direction direction, uint8_t flags, uint32_t device_id,
+                      const uint8_t *data, uint16_t length)
+{
+    // Without the trace ring the traffic is printed as it is recorded
+    kit_trace_print((uint8_t)direction, flags, (g_kit_trace_clock != NULL) ? g_kit_trace_clock() : 0, NULL,
+                    (data != NULL) ? data : (const uint8_t *)"", (data != NULL) ? length : 0, length);
+
+    return true;
+}
+
+bool kit_trace_record_text(enum kit_trace_direction direction, uint32_t device_id, const char *text)
+{
+    kit_trace_print((uint8_t)direction, 0, 0, text, (const uint8_t *)"", 0, 0);
+
+    return true;
+}
+
+uint16_t kit_trace_drain(uint16_t max_records)
+{
+    return 0;
+}
+
+uint32_t kit_trace_get_dropped(void)
+{
+    return 0;
+}
+
+#endif // KIT_PROTOCOL_TRACE
@@ -0,0 +1,154 @@
+/**
+ * \file
+ *
+ * \brief  KIT protocol deferred traffic trace
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#ifndef KIT_PROTOCOL_TRACE_H
+#define KIT_PROTOCOL_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#define KIT_TRACE_FLAG_CONTINUED  (0x01)  //! The next record completes the trace line (Ex. the talk command name)
+#define KIT_TRACE_FLAG_SEPARATE   (0x02)  //! The trace line is followed by an empty line (end of a device session)
+
+/**
+ * \brief The traffic direction of a trace record.
+ */
+enum kit_trace_direction
+{
+    KIT_TRACE_RECEIVED = 0,  //!< A message received from the host
+    KIT_TRACE_SENT,          //!< A response sent to the host
+    KIT_TRACE_COMMAND        //!< The name of the command sent to the device
+};
+
+/**
+ * \brief The trace clock, returns the current time (Ex. the milliseconds tick).
+ */
+typedef uint32_t (*kit_trace_clock_t)(void);
+
+/** \brief Sets the clock used to timestamp the trace records. The records are
+ *         timestamped 0 until it is called.
+ *
+ *  \param[in]    clock                  The trace clock, NULL to stop the timestamps
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_trace_set_clock(kit_trace_clock_t clock);
+
+/** \brief Records host traffic in the trace ring. The traffic is copied up to
+ *         KIT_TRACE_DATA_SIZE bytes, nothing is formatted or printed.
+ *
+ *  \note  The trace ring has a single producer (the protocol task) and a single
+ *         consumer (kit_trace_drain), neither blocks the other. Without
+ *         KIT_PROTOCOL_TRACE there is no ring and the traffic is printed here.
+ *
+ *  \param[in]    direction              The traffic direction
+ *                flags                  The KIT_TRACE_FLAG_ trace line flags
+ *                device_id              The selected device handle
+ *                data                   The traffic data
+ *                length                 The length of the traffic data
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return true when recorded, false when the trace ring is full (the record is dropped)
+ */
+bool kit_trace_record(enum kit_trace_direction direction, uint8_t flags, uint32_t device_id,
+                      const uint8_t *data, uint16_t length);
+
+/** \brief Records a text in the trace ring. Only the text pointer is recorded.
+ *
+ *  \param[in]    direction              The trace direction
+ *                device_id              The device handle
+ *                text                   The null-terminated text, it must stay valid until
+ *                                       drained (Ex. a command name string), NULL for none
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return true when recorded, false when the trace ring is full (the record is dropped)
+ */
+bool kit_trace_record_text(enum kit_trace_direction direction, uint32_t device_id, const char *text);
+
+/** \brief Formats and prints the pending trace records in the output console.
+ *         It is called from the idle loop, or from the drain thread.
+ *
+ *  \param[in]    max_records            The maximum number of records to print
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The number of records printed
+ */
+uint16_t kit_trace_drain(uint16_t max_records);
+
+/** \brief Returns the number of records dropped because the trace ring was full.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The number of dropped records
+ */
+uint32_t kit_trace_get_dropped(void);
+
+#ifdef KIT_TRACE_DRAIN_THREAD
+/** \brief Starts a thread which drains the trace ring, instead of the idle loop.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return true on success, otherwise false
+ */
+bool kit_trace_start_drain_thread(void);
+#endif // KIT_TRACE_DRAIN_THREAD
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // KIT_PROTOCOL_TRACE_H
@@ -34,101 +34,118 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "kit_protocol_hex_codec.h"
 #include "kit_protocol_utilities.h"
 
 uint8_t kit_protocol_convert_hex_to_nibble(uint8_t hex)
 {
-    if ((hex <= '9') && (hex >= '0'))
-    {
-        hex -= '0';
-    }
-    else if ((hex <= 'F' ) && (hex >= 'A'))
-    {
-        hex -= ('A' - 10);
-    }
-    else if ((hex <= 'f') && (hex >= 'a'))
-    {
-        hex -= ('a' - 10);
-    }
-    else
-    {
-        hex = 0;
-    }
+    const uint8_t nibble = g_kit_hex_decode_table[hex];
 
-    return hex;
+    // The characters which are not ASCII hex convert to 0
+    return (nibble & KIT_HEX_INVALID) ? 0 : nibble;
 }
 
 uint8_t kit_protocol_convert_nibble_to_hex(uint8_t nibble)
 {
-    nibble &= 0x0F;
+    // The second character of the byte 0x0n is the nibble n
+    return (uint8_t)g_kit_hex_encode_table[((nibble & 0x0F) * 2) + 1];
+}
 
-    if (nibble <= 0x09)
+uint16_t kit_protocol_convert_hex_to_binary(uint16_t length, uint8_t *buffer)
+{
+    return kit_protocol_convert_hex_to_binary_buffer(length, buffer, buffer);
+}
+
+uint16_t kit_protocol_convert_hex_to_binary_buffer(uint16_t length, const uint8_t *hex, uint8_t *binary)
+{
+    const uint16_t binary_length = (length / 2);
+
+    if ((hex == NULL) || (binary == NULL) || (length < 2))
     {
-        nibble += '0';
+        return 0;
     }
-    else
+
+    kit_hex_codec_decode(hex, binary_length, binary);
+
+    // An odd trailing character only provides the upper nibble
+    if ((length % 2) != 0)
     {
-        nibble += ('A' - 10);
+        binary[binary_length] = (uint8_t)(kit_protocol_convert_hex_to_nibble(hex[length - 1]) << 4);
+        return (binary_length + 1);
     }
 
-    return nibble;
+    return binary_length;
 }
 
-uint16_t kit_protocol_convert_hex_to_binary(uint16_t length, uint8_t *buffer)
+enum kit_protocol_status kit_protocol_convert_hex_to_binary_checked(uint16_t length, const uint8_t *hex, uint8_t *binary,
+                                                                    uint16_t *binary_length, uint16_t *error_offset)
 {
-    uint16_t index = 0;
-    uint16_t binary_index = 0;
-    uint8_t hex = 0;
+    uint32_t invalid_offset;
 
-    if ((buffer == NULL) || (length < 2))
+    if ((hex == NULL) || (binary == NULL) || (binary_length == NULL) || (error_offset == NULL))
     {
-        return 0;
+        return KIT_STATUS_INVALID_PARAM;
     }
 
-    for (index = 0, binary_index = 0; index < length; index += 2, binary_index++)
+    *binary_length = (length / 2);
+    *error_offset = 0;
+
+    invalid_offset = kit_hex_codec_decode(hex, *binary_length, binary);
+    if (invalid_offset != KIT_HEX_VALID)
     {
-        hex = buffer[index];
-        buffer[binary_index]  = (kit_protocol_convert_hex_to_nibble(hex) << 4);
+        *error_offset = (uint16_t)invalid_offset;
+        return KIT_STATUS_COMMAND_NOT_VALID;
+    }
 
-        hex = buffer[(index + 1)];
-        buffer[binary_index] |= kit_protocol_convert_hex_to_nibble(hex);
+    // An odd trailing character has no lower nibble
+    if ((length % 2) != 0)
+    {
+        *error_offset = (length - 1);
+        return KIT_STATUS_COMMAND_NOT_VALID;
     }
 
-    return binary_index;
+    return KIT_STATUS_SUCCESS;
 }
 
 uint16_t kit_protocol_convert_binary_to_hex(uint16_t length, uint8_t *buffer)
 {
-    const size_t hex_buffer_size = ((length * 2) + 1);
-
-    char *hex_buffer = NULL;
     uint16_t hex_length = 0;
 
-    if ((buffer == NULL) || (length == 0))
+    // The buffer holds the ASCII null-terminated hex buffer by contract
+    if (kit_protocol_convert_binary_to_hex_in_place(length, buffer, ((size_t)length * 2) + 1, &hex_length) != KIT_STATUS_SUCCESS)
     {
         return 0;
     }
 
-    // Allocate the memory needed for the ASCII hex buffer
-    if (NULL == (hex_buffer = (char*)malloc(hex_buffer_size)))
+    return hex_length;
+}
+
+enum kit_protocol_status kit_protocol_convert_binary_to_hex_in_place(uint16_t length, uint8_t *buffer, size_t capacity,
+                                                                     uint16_t *hex_length)
+{
+    const size_t required = ((size_t)length * 2) + 1;
+
+    if ((buffer == NULL) || (hex_length == NULL))
     {
-        return 0;
+        return KIT_STATUS_INVALID_PARAM;
     }
-    memset(hex_buffer, 0, hex_buffer_size);
 
-    for (uint16_t index = 0; index < length; index++)
+    *hex_length = 0;
+
+    if ((required > capacity) || (required > UINT16_MAX))
     {
-        hex_buffer[hex_length++] = (char)kit_protocol_convert_nibble_to_hex((buffer[index] >> 4));
-        hex_buffer[hex_length++] = (char)kit_protocol_convert_nibble_to_hex((buffer[index] & 0x0F));
+        // The ASCII hex buffer does not fit
+        return KIT_STATUS_SMALL_BUFFER;
     }
 
-    // Save the ASCII hex buffer
-    memcpy(buffer, hex_buffer, hex_length + 1);
+    buffer[length * 2] = '\0';
 
-    // Free the allocated memory
-    free(hex_buffer);
+    // The codec expands from the end, the ASCII hex characters of byte n are at 2n and 2n + 1 >= n
+    kit_hex_codec_encode(buffer, length, buffer);
 
-    return hex_length;
+    *hex_length = (uint16_t)(length * 2);
+
+    return KIT_STATUS_SUCCESS;
 }
 
 void kit_protocol_convert_to_lowercase(size_t length, char *buffer)
@@ -36,6 +36,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include "kit_protocol_status.h"
 
 // Set the packing alignment for the structure members
 #pragma pack(push, 1)
@@ -98,6 +99,42 @@ uint8_t kit_protocol_convert_nibble_to_hex(uint8_t nibble);
  */
 uint16_t kit_protocol_convert_hex_to_binary(uint16_t length, uint8_t *buffer);
 
+/** \brief Converts an ASCII hex buffer to a separate binary buffer.
+ *
+ *  \note  The binary buffer may alias the start of the ASCII hex buffer.
+ *
+ *  \param[in]    length                 The length of the ASCII buffer
+ *                hex                    The ASCII hex buffer
+ *
+ *  \param[out]   binary                 The binary buffer
+ *
+ *  \param[inout] None
+ *
+ *  \return The length of the binary buffer
+ */
+uint16_t kit_protocol_convert_hex_to_binary_buffer(uint16_t length, const uint8_t *hex, uint8_t *binary);
+
+/** \brief Converts an ASCII hex buffer to a separate binary buffer and checks
+ *         every character in the same pass.
+ *
+ *  \note  The binary buffer may alias the start of the ASCII hex buffer.
+ *
+ *  \param[in]    length                 The length of the ASCII buffer
+ *                hex                    The ASCII hex buffer
+ *
+ *  \param[out]   binary                 The binary buffer
+ *                binary_length          The length of the binary buffer
+ *                error_offset           The offset of the first character which is not ASCII
+ *                                       hex, or of the odd trailing character
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, KIT_STATUS_COMMAND_NOT_VALID when a
+ *          character is not ASCII hex or the length is odd
+ */
+enum kit_protocol_status kit_protocol_convert_hex_to_binary_checked(uint16_t length, const uint8_t *hex, uint8_t *binary,
+                                                                    uint16_t *binary_length, uint16_t *error_offset);
+
 /** \brief Converts an binary buffer to a ASCII null-terminated hex buffer.
  *
  *  \note  The buffer must have the allocated space needed to stored a
@@ -115,6 +152,27 @@ uint16_t kit_protocol_convert_hex_to_binary(uint16_t length, uint8_t *buffer);
  */
 uint16_t kit_protocol_convert_binary_to_hex(uint16_t length, uint8_t *buffer);
 
+/** \brief Converts a binary buffer to a ASCII null-terminated hex buffer in place,
+ *         without a temporary buffer.
+ *
+ *  \note  The conversion expands the data from the end of the buffer backwards,
+ *         so each binary byte is read before its ASCII hex characters overwrite it.
+ *
+ *  \param[in]    length                 The length of the binary buffer
+ *                capacity               The size, in bytes, of the buffer
+ *
+ *  \param[out]   hex_length             The length of the ASCII null-terminated hex buffer
+ *
+ *  \param[inout] buffer                 The buffer
+ *                                       IN  - The binary hex buffer
+ *                                       OUT - The ASCII null-terminated hex buffer
+ *
+ *  \return KIT_STATUS_SUCCESS on success, KIT_STATUS_SMALL_BUFFER when the ASCII
+ *          hex buffer does not fit in the capacity (the buffer is left unchanged)
+ */
+enum kit_protocol_status kit_protocol_convert_binary_to_hex_in_place(uint16_t length, uint8_t *buffer, size_t capacity,
+                                                                     uint16_t *hex_length);
+
 /** \brief Converts the null-terminated C string characters to lowercase characters.
  *
  *  \param[in]    length                The length, in bytes, of the null-terminated C string
@@ -0,0 +1,52 @@
+/**
+ * \file
+ *
+ * \brief  KIT protocol parser configuration of the emulator tests
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#ifndef KITPROTOCOL_PARSER_CONFIG_H_
+#define KITPROTOCOL_PARSER_CONFIG_H_
+
+/* The emulated devices are on I2C */
+#define KIT_HAL_I2C
+
+#define MAX_DISCOVER_DEVICES        8
+
+/* The emulator provides the microsecond delay and the clock */
+#define KIT_HAL_DELAY_US
+#define KIT_HAL_TIMER
+
+/* The commands under test; KIT_PROTOCOL_PIPELINE is set by the Makefile
+   for the pipeline build of the tests */
+#define KIT_PROTOCOL_TALK_ASYNC
+#define KIT_ASYNC_TICKETS           4
+#define KIT_ASYNC_EXPIRY_MS         10000
+#define KIT_PROTOCOL_SCRIPT
+
+#endif // KITPROTOCOL_PARSER_CONFIG_H_
@@ -0,0 +1,464 @@
+/**
+ * \file
+ *
+ * \brief  KIT protocol parser tests on the device emulator
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "kitprotocol_parser_config.h"
+#include "kit_protocol_api.h"
+#include "kit_protocol_init.h"
+#include "kit_protocol_interpreter.h"
+#include "kit_protocol_utilities.h"
+#include "kit_hal_interface.h"
+#include "kit_host_interface.h"
+#include "utilities/crc/crc_engines.h"
+#include "utilities/emulator/kit_hal_emulator.h"
+
+#define TEST_ECC_READ_OPCODE    (0x02)  //! The Read command of the ECC devices
+#define TEST_ECC_PACKET_SIZE    (7)     //! The size of a command packet without data
+
+// The USB host of the parser, the tests call the interpreter directly
+uint8_t g_usb_message_received;
+uint8_t g_usb_buffer[KIT_MESSAGE_SIZE_MAX];
+uint16_t g_usb_buffer_length;
+
+void usb_hid_init(void)
+{
+}
+
+uint8_t usb_send_message_response(uint8_t *message, uint16_t length)
+{
+    (void)message;
+    (void)length;
+
+    return 0;
+}
+
+static unsigned int g_test_checks;
+static unsigned int g_test_failures;
+static char g_test_response[KIT_MESSAGE_SIZE_MAX];
+
+#define TEST_CHECK(condition)               test_check(__LINE__, (condition), #condition)
+#define TEST_EXPECT(message, expected)      test_expect(__LINE__, (message), (expected))
+
+/** \brief Counts a check and reports it when it failed.
+ *
+ *  \param[in]    line                   The line of the check
+ *                passed                 Whether the check passed
+ *                text                   The text of the check
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void test_check(int line, bool passed, const char *text)
+{
+    g_test_checks++;
+    if (!passed)
+    {
+        g_test_failures++;
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, line, text);
+    }
+}
+
+/** \brief Handles a Kit protocol message.
+ *
+ *  \param[in]    message                The null-terminated message, with its delimiter
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The null-terminated response, without its delimiter
+ */
+static const char *test_message(const char *message)
+{
+    uint16_t length = (uint16_t)strlen(message);
+
+    memcpy(g_test_response, message, length + 1);
+    kit_interpreter_handle_message(g_test_response, &length);
+
+    while ((length > 0) && ((g_test_response[length - 1] == KIT_MESSAGE_DELIMITER) || (g_test_response[length - 1] == '\0')))
+    {
+        length--;
+    }
+    g_test_response[length] = '\0';
+
+    return g_test_response;
+}
+
+/** \brief Handles a Kit protocol message and checks its response.
+ *
+ *  \param[in]    line                   The line of the check
+ *                message                The null-terminated message, with its delimiter
+ *                expected               The expected response, without its delimiter
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void test_expect(int line, const char *message, const char *expected)
+{
+    const char *response = test_message(message);
+
+    g_test_checks++;
+    if (strcmp(response, expected) != 0)
+    {
+        g_test_failures++;
+        fprintf(stderr, "%s:%d: %.*s answered %s, expected %s\n", __FILE__, line, (int)strcspn(message, "\n"), message,
+                response, expected);
+    }
+}
+
+/** \brief Formats an ECC command packet without data, with its count byte and CRC.
+ *
+ *  \param[in]    opcode                 The command opcode
+ *                param1                 The command param1
+ *                param2                 The command param2
+ *
+ *  \param[out]   hex                    The ASCII hex packet, null-terminated
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void test_ecc_packet(char *hex, uint8_t opcode, uint8_t param1, uint16_t param2)
+{
+    uint8_t packet[TEST_ECC_PACKET_SIZE] = {TEST_ECC_PACKET_SIZE, opcode, param1, (uint8_t)param2, (uint8_t)(param2 >> 8)};
+    uint8_t index;
+
+    calculate_sha_ecc_crc(TEST_ECC_PACKET_SIZE - 2, packet, &packet[TEST_ECC_PACKET_SIZE - 2]);
+    for (index = 0; index < TEST_ECC_PACKET_SIZE; index++)
+    {
+        hex += sprintf(hex, "%02X", packet[index]);
+    }
+}
+
+/** \brief Lets the emulated time pass, the protocol task runs every millisecond.
+ *
+ *  \param[in]    time_ms                The time to wait, in milliseconds
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void test_wait(uint32_t time_ms)
+{
+    // The queued device commands progress in the protocol task, between the host messages
+    while (time_ms-- > 0)
+    {
+        kit_delay_ms(1);
+        kit_protocol_task(NULL);
+    }
+}
+
+/** \brief Selects the emulated ECC608B and wakes it up.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void test_select_ecc608(void)
+{
+    TEST_EXPECT("d:p:s(C0)\n", "00()");
+    TEST_EXPECT("d:w()\n", "00(04113343)");
+}
+
+/** \brief The command names are dispatched by their shortest unique prefix, in any case.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void test_dispatch(void)
+{
+    char version[64];
+    char read[2 * TEST_ECC_PACKET_SIZE + 1];
+    char message[64];
+    char response[64];
+
+    snprintf(version, sizeof(version), "%s", test_message("board:version()\n"));
+    TEST_CHECK(strncmp(version, "Parser ", 7) == 0);
+    TEST_EXPECT("b:v()\n", version);
+    TEST_EXPECT("B:V()\n", version);
+    TEST_EXPECT("bo:ver()\n", version);
+
+    TEST_EXPECT("b:zz()\n", "03()");
+    TEST_EXPECT("x:v()\n", "03()");
+    TEST_EXPECT("b:\n", "03()");
+
+    test_select_ecc608();
+    TEST_EXPECT("device:wake()\n", "00(04113343)");
+    TEST_EXPECT("D:WAKE()\n", "00(04113343)");
+
+    // talk and talk_async share their first letters
+    test_ecc_packet(read, TEST_ECC_READ_OPCODE, 0x00, 0x0000);
+    snprintf(message, sizeof(message), "d:talk(%s)\n", read);
+    snprintf(response, sizeof(response), "%s", test_message(message));
+    TEST_CHECK(strncmp(response, "00(07", 5) == 0);
+    snprintf(message, sizeof(message), "d:t(%s)\n", read);
+    TEST_EXPECT(message, response);
+
+    snprintf(message, sizeof(message), "d:talk_async(%s)\n", read);
+    snprintf(response, sizeof(response), "%s", test_message(message));
+    TEST_CHECK((strncmp(response, "00(", 3) == 0) && (strlen(response) == 6));
+    snprintf(message, sizeof(message), "d:cancel(%.2s)\n", &response[3]);
+    TEST_EXPECT(message, "00()");
+}
+
+/** \brief The device(<indexes>) messages run on each device, also in a pipeline.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void test_fanout(void)
+{
+    char read[2 * TEST_ECC_PACKET_SIZE + 1];
+    char message[64];
+    char data[64];
+    char expected[128];
+
+    // <count> then <index><status><length:2><response> of each device
+    TEST_EXPECT("d(00,01):w()\n", "00(0200000004041133430100000404113343)");
+    TEST_EXPECT("d(01):w()\n", "00(010100000404113343)");
+    TEST_EXPECT("d(*):w()\n", "00(03000000040411334301000004041133430200000404113343)");
+    TEST_EXPECT("d(05):w()\n", "C5()");
+    TEST_EXPECT("d(00,zz):w()\n", "03()");
+
+    // The fan-out response holds the device:talk response of the device
+    test_select_ecc608();
+    test_ecc_packet(read, TEST_ECC_READ_OPCODE, 0x00, 0x0000);
+    snprintf(message, sizeof(message), "d:t(%s)\n", read);
+    snprintf(data, sizeof(data), "%s", test_message(message) + 3);
+    data[strlen(data) - 1] = '\0';
+    snprintf(expected, sizeof(expected), "00(01000000%02X%s)", (unsigned int)(strlen(data) / 2), data);
+    snprintf(message, sizeof(message), "d(00):t(%s)\n", read);
+    TEST_EXPECT(message, expected);
+
+#ifdef KIT_PROTOCOL_PIPELINE
+    {
+        static const char *const messages[] = {"d(00,01):w()\n", "b:f(00)\n", "d(02):w()\n", "d(05):w()\n"};
+        char pipeline[256] = "";
+        char responses[256] = "";
+        char response[256];
+        uint16_t response_length = 0;
+        uint8_t index;
+
+        for (index = 0; index < (sizeof(messages) / sizeof(messages[0])); index++)
+        {
+            strcat(pipeline, messages[index]);
+            strcat(responses, test_message(messages[index]));
+            strcat(responses, "\n");
+        }
+
+        TEST_CHECK(kit_interpreter_handle_pipeline_ctx(kit_interpreter_get_default_ctx(), pipeline, (uint16_t)strlen(pipeline),
+                                                       response, sizeof(response), &response_length) == KIT_STATUS_SUCCESS);
+        TEST_CHECK((response_length == strlen(responses)) && (memcmp(response, responses, response_length) == 0));
+    }
+#endif // KIT_PROTOCOL_PIPELINE
+}
+
+/** \brief A device:talk_async ticket is polled once, cancelled or expires, and
+ *         the tickets in flight are bounded.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void test_talk_async(void)
+{
+    char read[2 * TEST_ECC_PACKET_SIZE + 1];
+    char talk[64];
+    char talk_response[64];
+    char message[64];
+    char tickets[KIT_ASYNC_TICKETS][3];
+    uint8_t index;
+
+    test_select_ecc608();
+    test_ecc_packet(read, TEST_ECC_READ_OPCODE, 0x00, 0x0000);
+    snprintf(message, sizeof(message), "d:t(%s)\n", read);
+    snprintf(talk_response, sizeof(talk_response), "%s", test_message(message));
+    snprintf(talk, sizeof(talk), "d:talk_async(%s)\n", read);
+
+    // The response is polled once, then the ticket is free
+    snprintf(tickets[0], sizeof(tickets[0]), "%.2s", test_message(talk) + 3);
+    snprintf(message, sizeof(message), "d:poll(%s)\n", tickets[0]);
+    TEST_EXPECT(message, "02()");
+    test_wait(10);
+    TEST_EXPECT(message, talk_response);
+    TEST_EXPECT(message, "E3()");
+    TEST_EXPECT("d:poll()\n", "E3()");
+
+    // The tickets in flight are bounded, a cancelled ticket is reused
+    for (index = 0; index < KIT_ASYNC_TICKETS; index++)
+    {
+        snprintf(tickets[index], sizeof(tickets[index]), "%.2s", test_message(talk) + 3);
+        TEST_CHECK(strncmp(g_test_response, "00(", 3) == 0);
+    }
+    TEST_CHECK(strncmp(test_message(talk), "00(", 3) != 0);
+
+    snprintf(message, sizeof(message), "d:cancel(%s)\n", tickets[KIT_ASYNC_TICKETS - 1]);
+    TEST_EXPECT(message, "00()");
+    TEST_EXPECT(message, "E3()");
+    snprintf(tickets[KIT_ASYNC_TICKETS - 1], sizeof(tickets[0]), "%.2s", test_message(talk) + 3);
+    TEST_CHECK(strncmp(g_test_response, "00(", 3) == 0);
+
+    // The queued commands run in order
+    test_wait(100);
+    for (index = 0; index < KIT_ASYNC_TICKETS; index++)
+    {
+        snprintf(message, sizeof(message), "d:poll(%s)\n", tickets[index]);
+        TEST_EXPECT(message, talk_response);
+    }
+
+    // A response not polled in time is dropped
+    snprintf(tickets[0], sizeof(tickets[0]), "%.2s", test_message(talk) + 3);
+    test_wait(10);
+    snprintf(message, sizeof(message), "d:poll(%s)\n", tickets[0]);
+    test_wait(KIT_ASYNC_EXPIRY_MS + 1000);
+    TEST_EXPECT(message, "E3()");
+}
+
+/** \brief A board:script talks to the device and checks its responses.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void test_script(void)
+{
+    test_select_ecc608();
+
+    // wake, load a Read packet, update its CRC, talk, expect the count byte 07, sleep;
+    // the response is the end offset and the Read response
+    TEST_EXPECT("b:s(0104000707020000000000060708000703)\n", "00(00110702030405DD61)");
+    // The expected byte is not the response one, the script stops at the EXPECT
+    TEST_EXPECT("b:s(0104000707020000000000060708000803)\n", "F4(000D0702030405DD61)");
+    // A malformed script sends nothing
+    TEST_EXPECT("b:s(010400)\n", "E2(0000)");
+    TEST_EXPECT("b:s(09)\n", "E2(0000)");
+
+    TEST_EXPECT("d:p:s(2E)\n", "00()");
+    TEST_EXPECT("b:s(0104000707020000000000060708000703)\n", "04()");
+}
+
+/** \brief The hex codec handles the odd and zero lengths.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void test_hex_codec(void)
+{
+    uint8_t binary[8];
+    uint8_t hex[8];
+    uint16_t length;
+    uint16_t error_offset;
+
+    // An odd trailing character only provides the upper nibble
+    TEST_CHECK(kit_protocol_convert_hex_to_binary_buffer(3, (const uint8_t *)"AbC", binary) == 2);
+    TEST_CHECK((binary[0] == 0xAB) && (binary[1] == 0xC0));
+    TEST_CHECK(kit_protocol_convert_hex_to_binary_buffer(1, (const uint8_t *)"A", binary) == 0);
+    TEST_CHECK(kit_protocol_convert_hex_to_binary_buffer(0, (const uint8_t *)"", binary) == 0);
+
+    // The checked conversion refuses the odd trailing character
+    TEST_CHECK(kit_protocol_convert_hex_to_binary_checked(3, (const uint8_t *)"ABC", binary, &length, &error_offset) ==
+               KIT_STATUS_COMMAND_NOT_VALID);
+    TEST_CHECK(error_offset == 2);
+    TEST_CHECK(kit_protocol_convert_hex_to_binary_checked(4, (const uint8_t *)"AB0G", binary, &length, &error_offset) ==
+               KIT_STATUS_COMMAND_NOT_VALID);
+    TEST_CHECK(error_offset == 3);
+    TEST_CHECK(kit_protocol_convert_hex_to_binary_checked(0, (const uint8_t *)"", binary, &length, &error_offset) ==
+               KIT_STATUS_SUCCESS);
+    TEST_CHECK(length == 0);
+
+    memset(hex, 0xFF, sizeof(hex));
+    hex[0] = 0xAB;
+    hex[1] = 0x01;
+    TEST_CHECK(kit_protocol_convert_binary_to_hex_in_place(2, hex, sizeof(hex), &length) == KIT_STATUS_SUCCESS);
+    TEST_CHECK((length == 4) && (strcmp((const char *)hex, "AB01") == 0));
+    TEST_CHECK(kit_protocol_convert_binary_to_hex_in_place(2, hex, 4, &length) == KIT_STATUS_SMALL_BUFFER);
+    TEST_CHECK(kit_protocol_convert_binary_to_hex_in_place(0, hex, sizeof(hex), &length) == KIT_STATUS_SUCCESS);
+    TEST_CHECK((length == 0) && (hex[0] == '\0'));
+
+    // The parser refuses the odd and the invalid data
+    test_select_ecc608();
+    TEST_EXPECT("d:t(070)\n", "03()");
+    TEST_EXPECT("d:t(07Z2000000)\n", "03()");
+}
+
+int main(void)
+{
+    host_iface_init();
+    kit_protocol_init();
+    hardware_interface_discover();
+
+    test_dispatch();
+    test_fanout();
+    test_talk_async();
+    test_script();
+    test_hex_codec();
+
+    fprintf(stderr, "%u checks, %u failed\n", g_test_checks, g_test_failures);
+
+    return (g_test_failures == 0) ? 0 : 1;
+}
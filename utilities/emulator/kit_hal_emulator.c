@@ -0,0 +1,754 @@
+/**
+ * \file
+ *
+ * \brief  Emulated CryptoAuth devices behind the HAL interface
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#ifdef KIT_HAL_EMULATOR
+
+#include <string.h>
+#include "kit_hal_emulator.h"
+#include "utilities/crc/crc_engines.h"
+
+#define KIT_EMULATOR_RESPONSE_SIZE   (256)   // The response buffer of each device
+#define KIT_EMULATOR_ECC_CRC_SIZE    (2)     // The CRC of the count byte framed packets
+#define KIT_EMULATOR_ECC_CMD_MIN     (7)     // <count><opcode><param1><param2:2><crc:2>
+#define KIT_EMULATOR_TA_LENGTH_IDX   (1)     // <instruction><length:2><opcode><mode>... of the TA10x packets
+#define KIT_EMULATOR_TA_OPCODE_IDX   (3)
+#define KIT_EMULATOR_TA_MODE_IDX     (4)
+#define KIT_EMULATOR_TA_CMD_MIN      (12)    // <length:2><opcode><mode><param1:2><param2:4><crc:2>
+
+// Device status codes of the emulated responses
+#define KIT_EMULATOR_STATUS_SUCCESS  ((uint8_t)0x00)
+#define KIT_EMULATOR_STATUS_PARSE    ((uint8_t)0x03)  // Unknown opcode
+#define KIT_EMULATOR_STATUS_CRC      ((uint8_t)0xFF)  // Bad CRC or framing
+
+struct kit_emulator_device
+{
+    interface_id_t bus_type;
+    device_type_t device_type;
+    uint8_t address;
+    bool awake;                                         // The ECC devices need a wake, the TA10x ones are always awake
+    uint64_t awake_time_us;                             // When the device woke up, for its watchdog
+    uint64_t ready_time_us;                             // When the response can be read
+    uint16_t response_length;                           // 0 when there is no response to read
+    uint8_t response[KIT_EMULATOR_RESPONSE_SIZE];
+};
+
+struct kit_emulator_ta_response_size
+{
+    uint8_t opcode;
+    uint8_t data_size;                                  // The data following the status byte
+};
+
+struct kit_emulator_execution_time
+{
+    device_type_t device_type;
+    uint8_t opcode;
+    uint32_t time_us;
+};
+
+static struct kit_emulator_device g_kit_emulator_devices[KIT_EMULATOR_DEVICES] =
+{
+    {.bus_type = DEVKIT_IF_I2C, .device_type = DEVICE_TYPE_ECC608B, .address = 0xC0},
+    {.bus_type = DEVKIT_IF_I2C, .device_type = DEVICE_TYPE_ECC204, .address = 0x66},
+    {.bus_type = DEVKIT_IF_I2C, .device_type = DEVICE_TYPE_TA100, .address = 0x2E},
+};
+static uint8_t g_kit_emulator_device_count = 3;
+static struct kit_emulator_execution_time g_kit_emulator_execution_times[KIT_EMULATOR_OVERRIDES];
+static uint8_t g_kit_emulator_execution_time_count;
+static struct kit_emulator_stats g_kit_emulator_stats;
+static uint64_t g_kit_emulator_time_us;
+static const uint8_t g_kit_emulator_wake_response[] = {0x04, 0x11, 0x33, 0x43};
+
+// The TA10x response data of the P256 and 32 byte forms of the commands, the
+// other commands only return their status
+static const struct kit_emulator_ta_response_size g_kit_emulator_ta_response_sizes[] =
+{
+    {ATCA_TA_INFO, 8},          // Revision
+    {ATCA_TA_RANDOM, 32},
+    {ATCA_TA_READ, 32},
+    {ATCA_TA_COUNTER, 4},
+    {ATCA_TA_KEYGEN, 64},       // Public key
+    {ATCA_TA_SIGN, 64},
+    {ATCA_TA_ECDH, 32},
+    {ATCA_TA_SHA, 32},          // Digest
+    {ATCA_TA_MAC, 32},
+    {ATCA_TA_KDF, 32},
+    {ATCA_TA_AES, 16},
+};
+
+void kit_emulator_clear_devices(void)
+{
+    g_kit_emulator_device_count = 0;
+}
+
+enum kit_protocol_status kit_emulator_add_device(interface_id_t bus_type, device_type_t device_type, uint8_t address)
+{
+    struct kit_emulator_device *device;
+
+    if ((bus_type == DEVKIT_IF_UNKNOWN) || (bus_type >= DEVKIT_IF_LAST) || (device_type == DEVICE_TYPE_UNKNOWN))
+    {
+        return KIT_STATUS_INVALID_PARAM;
+    }
+
+    if (g_kit_emulator_device_count >= KIT_EMULATOR_DEVICES)
+    {
+        return KIT_STATUS_SMALL_BUFFER;
+    }
+
+    device = &g_kit_emulator_devices[g_kit_emulator_device_count++];
+    memset(device, 0, sizeof(*device));
+    device->bus_type = bus_type;
+    device->device_type = device_type;
+    device->address = address;
+
+    return KIT_STATUS_SUCCESS;
+}
+
+enum kit_protocol_status kit_emulator_set_execution_time(device_type_t device_type, uint8_t opcode, uint32_t time_us)
+{
+    struct kit_emulator_execution_time *execution_time;
+    uint8_t index;
+
+    for (index = 0; index < g_kit_emulator_execution_time_count; index++)
+    {
+        execution_time = &g_kit_emulator_execution_times[index];
+        if ((execution_time->device_type == device_type) && (execution_time->opcode == opcode))
+        {
+            execution_time->time_us = time_us;
+            return KIT_STATUS_SUCCESS;
+        }
+    }
+
+    if (g_kit_emulator_execution_time_count >= KIT_EMULATOR_OVERRIDES)
+    {
+        return KIT_STATUS_SMALL_BUFFER;
+    }
+
+    execution_time = &g_kit_emulator_execution_times[g_kit_emulator_execution_time_count++];
+    execution_time->device_type = device_type;
+    execution_time->opcode = opcode;
+    execution_time->time_us = time_us;
+
+    return KIT_STATUS_SUCCESS;
+}
+
+void kit_emulator_reset(void)
+{
+    uint8_t index;
+
+    for (index = 0; index < g_kit_emulator_device_count; index++)
+    {
+        g_kit_emulator_devices[index].awake = false;
+        g_kit_emulator_devices[index].response_length = 0;
+    }
+
+    memset(&g_kit_emulator_stats, 0, sizeof(g_kit_emulator_stats));
+    g_kit_emulator_time_us = 0;
+}
+
+uint64_t kit_emulator_get_time_us(void)
+{
+    return g_kit_emulator_time_us;
+}
+
+const struct kit_emulator_stats *kit_emulator_get_stats(void)
+{
+    return &g_kit_emulator_stats;
+}
+
+void kit_delay_ms(uint32_t delay_in_ms)
+{
+    g_kit_emulator_time_us += (uint64_t)delay_in_ms * 1000;
+}
+
+#ifdef KIT_HAL_DELAY_US
+void kit_delay_us(uint32_t delay_in_us)
+{
+    g_kit_emulator_time_us += delay_in_us;
+}
+#endif // KIT_HAL_DELAY_US
+
+#ifdef KIT_HAL_TIMER
+uint32_t kit_get_time_ms(void)
+{
+    // Reading the clock takes time too, the loops polling it make progress
+    g_kit_emulator_time_us += KIT_EMULATOR_CLOCK_READ_US;
+
+    return (uint32_t)(g_kit_emulator_time_us / 1000);
+}
+#endif // KIT_HAL_TIMER
+
+/** \brief Finds an emulated device, and puts it to sleep when its watchdog expired.
+ *
+ *  \param[in]    bus_type               The device interface
+ *                address                The device address
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the emulated device, NULL when there is none
+ */
+static struct kit_emulator_device *kit_emulator_get_device(interface_id_t bus_type, uint32_t address)
+{
+    struct kit_emulator_device *device;
+    uint16_t watchdog_time_ms;
+    uint8_t index;
+
+    for (index = 0; index < g_kit_emulator_device_count; index++)
+    {
+        device = &g_kit_emulator_devices[index];
+        if ((device->bus_type != bus_type) || (device->address != address))
+        {
+            continue;
+        }
+
+        watchdog_time_ms = get_device_watchdog_time(device->device_type);
+        if (device->awake && (watchdog_time_ms != 0) &&
+            ((g_kit_emulator_time_us - device->awake_time_us) >= ((uint64_t)watchdog_time_ms * 1000)))
+        {
+            device->awake = false;
+            device->response_length = 0;
+        }
+
+        return device;
+    }
+
+    return NULL;
+}
+
+/** \brief Returns whether a device needs no wake token.
+ *
+ *  \param[in]    device                 The emulated device
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return true for the TA10x devices
+ */
+static bool kit_emulator_is_always_awake(const struct kit_emulator_device *device)
+{
+    return check_ta_device(device->device_type);
+}
+
+/** \brief Returns the execution time of a command, the configured one first.
+ *
+ *  \param[in]    device                 The emulated device
+ *                opcode                 The command opcode
+ *                mode                   The command mode (param1)
+ *
+ *  \param[out]   time_us                The execution time, in microseconds
+ *
+ *  \param[inout] None
+ *
+ *  \return true when the device knows the command
+ */
+static bool kit_emulator_get_execution_time(const struct kit_emulator_device *device, uint8_t opcode, uint8_t mode,
+                                            uint32_t *time_us)
+{
+    const opcode_execution_time_t *execution_time;
+    uint8_t index;
+
+    for (index = 0; index < g_kit_emulator_execution_time_count; index++)
+    {
+        if ((g_kit_emulator_execution_times[index].device_type == device->device_type) &&
+            (g_kit_emulator_execution_times[index].opcode == opcode))
+        {
+            *time_us = g_kit_emulator_execution_times[index].time_us;
+            return true;
+        }
+    }
+
+    if ((execution_time = get_device_execution_time(device->device_type, opcode, mode)) == NULL)
+    {
+        return false;
+    }
+
+    *time_us = execution_time->typical_time_us;
+
+    return true;
+}
+
+/** \brief Returns the response payload size of an ECC or ECC204 command, the
+ *         response only holds the status byte when it is 1.
+ *
+ *  \param[in]    device                 The emulated device
+ *                packet                 The command packet
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the payload size
+ */
+static uint8_t kit_emulator_ecc_payload_size(const struct kit_emulator_device *device, uint8_t *packet)
+{
+    // The ECC204 family (ECC204 to SHA106) has its own commands
+    const bool is_ecc204 = (device->device_type >= DEVICE_TYPE_ECC204) && (device->device_type <= DEVICE_TYPE_SHA106);
+    uint8_t response_size = ECC108_RSP_SIZE_MIN;
+
+    if (!is_ecc204)
+    {
+        response_size = get_eccx08_response_size(packet);
+    }
+    else if (packet[ECC108_OPCODE_IDX] == ECC204_READ)
+    {
+        response_size = READ_32_RSP_SIZE;
+    }
+    else if (packet[ECC108_OPCODE_IDX] == ECC204_INFO)
+    {
+        response_size = INFO_RSP_SIZE;
+    }
+
+    return (uint8_t)(response_size - 1 - KIT_EMULATOR_ECC_CRC_SIZE);
+}
+
+/** \brief Returns the response payload size of a TA10x command, its status byte
+ *         and data.
+ *
+ *  \param[in]    opcode                 The command opcode
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the payload size
+ */
+static uint8_t kit_emulator_ta_payload_size(uint8_t opcode)
+{
+    uint8_t index;
+
+    for (index = 0; index < (sizeof(g_kit_emulator_ta_response_sizes) / sizeof(g_kit_emulator_ta_response_sizes[0])); index++)
+    {
+        if (g_kit_emulator_ta_response_sizes[index].opcode == opcode)
+        {
+            return (uint8_t)(1 + g_kit_emulator_ta_response_sizes[index].data_size);
+        }
+    }
+
+    return 1;
+}
+
+/** \brief Builds the response of a device, framed for its family, with a
+ *         deterministic payload.
+ *
+ *  \param[in]    opcode                 The command opcode, it seeds the payload
+ *                status                 The device status, the whole payload when it is not 0
+ *                payload_size           The payload size of a successful command
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] device                 The emulated device
+ *
+ *  \return None
+ */
+static void kit_emulator_set_response(struct kit_emulator_device *device, uint8_t opcode, uint8_t status, uint16_t payload_size)
+{
+    const bool is_ta = check_ta_device(device->device_type);
+    const uint16_t header_size = is_ta ? 2 : 1;
+    uint8_t *payload = &device->response[header_size];
+    uint16_t length;
+    uint16_t crc;
+    uint16_t index;
+
+    if ((status != KIT_EMULATOR_STATUS_SUCCESS) || (payload_size == 0))
+    {
+        payload_size = 1;
+    }
+
+    if (is_ta)
+    {
+        // The TA10x responses start with their status byte
+        payload[0] = status;
+        for (index = 1; index < payload_size; index++)
+        {
+            payload[index] = (uint8_t)(opcode + index);
+        }
+    }
+    else
+    {
+        for (index = 0; index < payload_size; index++)
+        {
+            payload[index] = (payload_size == 1) ? status : (uint8_t)(opcode + index);
+        }
+    }
+
+    length = (uint16_t)(header_size + payload_size + KIT_EMULATOR_ECC_CRC_SIZE);
+    if (is_ta)
+    {
+        // <length:2><status><data><crc:2>, the CRC is big endian
+        device->response[0] = (uint8_t)(length >> 8);
+        device->response[1] = (uint8_t)length;
+        calc_ta_crc((uint16_t)(length - KIT_EMULATOR_ECC_CRC_SIZE), device->response, &crc);
+        device->response[length - 2] = (uint8_t)(crc >> 8);
+        device->response[length - 1] = (uint8_t)crc;
+    }
+    else
+    {
+        // <count><data><crc:2>, the CRC is little endian
+        device->response[0] = (uint8_t)length;
+        calculate_sha_ecc_crc((uint8_t)(length - KIT_EMULATOR_ECC_CRC_SIZE), device->response,
+                              &device->response[length - KIT_EMULATOR_ECC_CRC_SIZE]);
+    }
+
+    device->response_length = length;
+}
+
+/** \brief Emulates the wake token.
+ *
+ *  \param[in]    bus_type               The device interface
+ *                address                The device address
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+static enum kit_protocol_status kit_emulator_wake(interface_id_t bus_type, uint32_t address)
+{
+    struct kit_emulator_device *device = kit_emulator_get_device(bus_type, address);
+
+    g_kit_emulator_stats.bus_time_us += KIT_EMULATOR_BYTE_TIME_US;
+    g_kit_emulator_time_us += KIT_EMULATOR_BYTE_TIME_US;
+
+    if (device == NULL)
+    {
+        return KIT_STATUS_SUCCESS;
+    }
+
+    // The watchdog of an awake device keeps running, it only answers the wake again
+    if (!device->awake)
+    {
+        g_kit_emulator_stats.wakes++;
+        device->awake = true;
+        device->awake_time_us = g_kit_emulator_time_us;
+        device->ready_time_us = g_kit_emulator_time_us + get_device_wake_delay(device->device_type, bus_type);
+    }
+    memcpy(device->response, g_kit_emulator_wake_response, sizeof(g_kit_emulator_wake_response));
+    device->response_length = sizeof(g_kit_emulator_wake_response);
+
+    return KIT_STATUS_SUCCESS;
+}
+
+/** \brief Emulates the idle and sleep tokens, both need a wake before the next command.
+ *
+ *  \param[in]    bus_type               The device interface
+ *                address                The device address
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+static enum kit_protocol_status kit_emulator_standby(interface_id_t bus_type, uint32_t address)
+{
+    struct kit_emulator_device *device = kit_emulator_get_device(bus_type, address);
+
+    g_kit_emulator_stats.bus_time_us += KIT_EMULATOR_BYTE_TIME_US;
+    g_kit_emulator_time_us += KIT_EMULATOR_BYTE_TIME_US;
+
+    if ((device != NULL) && !kit_emulator_is_always_awake(device))
+    {
+        device->awake = false;
+        device->response_length = 0;
+    }
+
+    return KIT_STATUS_SUCCESS;
+}
+
+/** \brief Emulates a command packet: the framing and the CRC are checked and the
+ *         response is ready once the command execution time is over.
+ *
+ *  \param[in]    bus_type               The device interface
+ *                address                The device address
+ *                message                The command packet
+ *                length                 The length of the command packet
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, KIT_STATUS_TX_FAIL when the device does not
+ *          acknowledge (not there or not awake)
+ */
+static enum kit_protocol_status kit_emulator_send(interface_id_t bus_type, uint32_t address, uint8_t *message, uint16_t *length)
+{
+    struct kit_emulator_device *device = kit_emulator_get_device(bus_type, address);
+    const bool is_ta = (device != NULL) && check_ta_device(device->device_type);
+    uint16_t packet_length;
+    uint32_t time_us = 0;
+    uint8_t crc_bytes[KIT_EMULATOR_ECC_CRC_SIZE];
+    uint8_t opcode;
+    uint8_t mode;
+    uint8_t status = KIT_EMULATOR_STATUS_SUCCESS;
+
+    g_kit_emulator_stats.bus_time_us += (uint64_t)*length * KIT_EMULATOR_BYTE_TIME_US;
+    g_kit_emulator_time_us += (uint64_t)*length * KIT_EMULATOR_BYTE_TIME_US;
+
+    if ((device == NULL) || !(device->awake || kit_emulator_is_always_awake(device)))
+    {
+        return KIT_STATUS_TX_FAIL;
+    }
+
+    if (is_ta)
+    {
+        // <instruction><length:2><opcode><mode><param1:2><param2:4><data><crc:2>
+        packet_length = (*length > KIT_EMULATOR_TA_LENGTH_IDX) ?
+                        (uint16_t)((message[KIT_EMULATOR_TA_LENGTH_IDX] << 8) | message[KIT_EMULATOR_TA_LENGTH_IDX + 1]) : 0;
+        if ((*length <= KIT_EMULATOR_TA_CMD_MIN) || (packet_length != (*length - KIT_EMULATOR_TA_LENGTH_IDX)) ||
+            !check_ta_crc(&message[KIT_EMULATOR_TA_LENGTH_IDX], (uint16_t)(packet_length - KIT_EMULATOR_ECC_CRC_SIZE)))
+        {
+            status = KIT_EMULATOR_STATUS_CRC;
+        }
+        opcode = (*length > KIT_EMULATOR_TA_MODE_IDX) ? message[KIT_EMULATOR_TA_OPCODE_IDX] : 0;
+        mode = (*length > KIT_EMULATOR_TA_MODE_IDX) ? message[KIT_EMULATOR_TA_MODE_IDX] : 0;
+    }
+    else
+    {
+        // <count><opcode><param1><param2:2><data><crc:2>
+        if ((*length < KIT_EMULATOR_ECC_CMD_MIN) || (message[ECC108_COUNT_IDX] != *length))
+        {
+            status = KIT_EMULATOR_STATUS_CRC;
+        }
+        else
+        {
+            calculate_sha_ecc_crc((uint8_t)(*length - KIT_EMULATOR_ECC_CRC_SIZE), message, crc_bytes);
+            if (memcmp(crc_bytes, &message[*length - KIT_EMULATOR_ECC_CRC_SIZE], sizeof(crc_bytes)) != 0)
+            {
+                status = KIT_EMULATOR_STATUS_CRC;
+            }
+        }
+        opcode = (*length > ECC108_PARAM1_IDX) ? message[ECC108_OPCODE_IDX] : 0;
+        mode = (*length > ECC108_PARAM1_IDX) ? message[ECC108_PARAM1_IDX] : 0;
+    }
+
+    if (status != KIT_EMULATOR_STATUS_SUCCESS)
+    {
+        g_kit_emulator_stats.crc_errors++;
+    }
+    else if (!kit_emulator_get_execution_time(device, opcode, mode, &time_us))
+    {
+        status = KIT_EMULATOR_STATUS_PARSE;
+    }
+    else
+    {
+        g_kit_emulator_stats.commands++;
+    }
+
+    kit_emulator_set_response(device, opcode, status,
+                              is_ta ? kit_emulator_ta_payload_size(opcode) : kit_emulator_ecc_payload_size(device, message));
+    device->ready_time_us = g_kit_emulator_time_us + time_us;
+
+    return KIT_STATUS_SUCCESS;
+}
+
+/** \brief Emulates a response read, refused while the device is asleep or busy.
+ *
+ *  \param[in]    bus_type               The device interface
+ *                address                The device address
+ *
+ *  \param[out]   message                The response packet
+ *
+ *  \param[inout] length                 As input, the number of bytes to read
+ *                                       As output, the number of bytes read
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise KIT_STATUS_RX_NO_RESPONSE
+ */
+static enum kit_protocol_status kit_emulator_receive(interface_id_t bus_type, uint32_t address, uint8_t *message, uint16_t *length)
+{
+    struct kit_emulator_device *device = kit_emulator_get_device(bus_type, address);
+    uint16_t count;
+
+    g_kit_emulator_stats.bus_time_us += KIT_EMULATOR_BYTE_TIME_US;
+    g_kit_emulator_time_us += KIT_EMULATOR_BYTE_TIME_US;
+
+    if ((device == NULL) || (device->response_length == 0) || (g_kit_emulator_time_us < device->ready_time_us))
+    {
+        g_kit_emulator_stats.busy_polls++;
+        *length = 0;
+        return KIT_STATUS_RX_NO_RESPONSE;
+    }
+
+    count = (*length < device->response_length) ? *length : device->response_length;
+    memcpy(message, device->response, count);
+    *length = count;
+    device->response_length = 0;
+
+    g_kit_emulator_stats.bus_time_us += (uint64_t)count * KIT_EMULATOR_BYTE_TIME_US;
+    g_kit_emulator_time_us += (uint64_t)count * KIT_EMULATOR_BYTE_TIME_US;
+
+    return KIT_STATUS_SUCCESS;
+}
+
+/** \brief Emulates a talk: the command is sent, the clock moves to the end of its
+ *         execution and the response is read.
+ *
+ *  \param[in]    bus_type               The device interface
+ *                address                The device address
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] message                As input, the command packet
+ *                                       As output, the response packet
+ *                length                 As input, the length of the command packet
+ *                                       As output, the length of the response packet
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+static enum kit_protocol_status kit_emulator_talk(interface_id_t bus_type, uint32_t address, uint8_t *message, uint16_t *length)
+{
+    enum kit_protocol_status status;
+    struct kit_emulator_device *device;
+
+    if ((status = kit_emulator_send(bus_type, address, message, length)) != KIT_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    device = kit_emulator_get_device(bus_type, address);
+    if (g_kit_emulator_time_us < device->ready_time_us)
+    {
+        g_kit_emulator_time_us = device->ready_time_us;
+    }
+
+    *length = KIT_EMULATOR_RESPONSE_SIZE;
+
+    return kit_emulator_receive(bus_type, address, message, length);
+}
+
+/** \brief Emulates the device discovery of a bus.
+ *
+ *  \param[in]    bus_type               The interface
+ *
+ *  \param[out]   device_info            The discovered devices
+ *                device_count           The number of discovered devices
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+static void kit_emulator_discover(interface_id_t bus_type, device_info_t *device_info, uint8_t *device_count)
+{
+    const struct kit_emulator_device *device;
+    uint8_t index;
+
+    *device_count = 0;
+
+    for (index = 0; index < g_kit_emulator_device_count; index++)
+    {
+        device = &g_kit_emulator_devices[index];
+        if (device->bus_type != bus_type)
+        {
+            continue;
+        }
+
+        memset(&device_info[*device_count], 0, sizeof(device_info[*device_count]));
+        device_info[*device_count].bus_type = bus_type;
+        device_info[*device_count].device_type = device->device_type;
+        device_info[*device_count].address = device->address;
+        device_info[*device_count].device_index = *device_count;
+        (*device_count)++;
+    }
+}
+
+#ifdef KIT_HAL_TALK_ASYNC
+#define KIT_EMULATOR_TALK_ASYNC(prefix, bus)                                                                    \
+    enum kit_protocol_status hal_##prefix##_talk_start(uint32_t address, uint8_t *message, uint16_t *length)    \
+    {                                                                                                           \
+        return kit_emulator_send(bus, address, message, length);                                                \
+    }                                                                                                           \
+    enum kit_protocol_status hal_##prefix##_talk_complete(uint32_t address, uint8_t *message, uint16_t *length) \
+    {                                                                                                           \
+        const enum kit_protocol_status status = kit_emulator_receive(bus, address, message, length);            \
+        return (status == KIT_STATUS_RX_NO_RESPONSE) ? KIT_STATUS_PENDING : status;                             \
+    }
+#else
+#define KIT_EMULATOR_TALK_ASYNC(prefix, bus)
+#endif // KIT_HAL_TALK_ASYNC
+
+// The HAL functions of a bus, they all lead to the emulated devices of the bus
+#define KIT_EMULATOR_BUS(prefix, bus)                                                                           \
+    void hal_##prefix##_init(void)                                                                              \
+    {                                                                                                           \
+    }                                                                                                           \
+    void hal_##prefix##_deinit(void)                                                                            \
+    {                                                                                                           \
+    }                                                                                                           \
+    void hal_##prefix##_discover(device_info_t *device_info, uint8_t *device_count)                             \
+    {                                                                                                           \
+        kit_emulator_discover(bus, device_info, device_count);                                                  \
+    }                                                                                                           \
+    enum kit_protocol_status hal_##prefix##_wake(uint32_t address)                                              \
+    {                                                                                                           \
+        return kit_emulator_wake(bus, address);                                                                 \
+    }                                                                                                           \
+    enum kit_protocol_status hal_##prefix##_sleep(uint32_t address)                                             \
+    {                                                                                                           \
+        return kit_emulator_standby(bus, address);                                                              \
+    }                                                                                                           \
+    enum kit_protocol_status hal_##prefix##_idle(uint32_t address)                                              \
+    {                                                                                                           \
+        return kit_emulator_standby(bus, address);                                                              \
+    }                                                                                                           \
+    enum kit_protocol_status hal_##prefix##_send(uint32_t address, uint8_t *message, uint16_t *length)          \
+    {                                                                                                           \
+        return kit_emulator_send(bus, address, message, length);                                                \
+    }                                                                                                           \
+    enum kit_protocol_status hal_##prefix##_receive(uint32_t address, uint8_t *message, uint16_t *length)       \
+    {                                                                                                           \
+        return kit_emulator_receive(bus, address, message, length);                                             \
+    }                                                                                                           \
+    enum kit_protocol_status hal_##prefix##_talk(uint32_t address, uint8_t *message, uint16_t *length)          \
+    {                                                                                                           \
+        return kit_emulator_talk(bus, address, message, length);                                                \
+    }                                                                                                           \
+    KIT_EMULATOR_TALK_ASYNC(prefix, bus)
+
+#ifdef KIT_HAL_I2C
+KIT_EMULATOR_BUS(i2c, DEVKIT_IF_I2C)
+#endif
+
+#ifdef KIT_HAL_SWI
+KIT_EMULATOR_BUS(swi, DEVKIT_IF_SWI)
+#endif
+
+#ifdef KIT_HAL_SPI
+KIT_EMULATOR_BUS(spi, DEVKIT_IF_SPI)
+#endif
+
+#ifdef KIT_HAL_SWI2
+KIT_EMULATOR_BUS(gpio, DEVKIT_IF_SWI2)
+#endif
+
+#endif // KIT_HAL_EMULATOR
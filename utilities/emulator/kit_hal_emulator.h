@@ -0,0 +1,161 @@
+/**
+ * \file
+ *
+ * \brief  Emulated CryptoAuth devices behind the HAL interface
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*
+ * Emulated HAL backend, it answers the HAL calls of the parser with software
+ * devices so the parser, the scheduler and the device handling can be run and
+ * load tested without boards. The emulator provides hal_<bus>_*() of the
+ * compiled buses, kit_delay_ms(), kit_delay_us() and kit_get_time_ms(), on a
+ * simulated clock; build it in place of the platform HAL with -DKIT_HAL_EMULATOR.
+ */
+
+#ifndef KIT_HAL_EMULATOR_H
+#define KIT_HAL_EMULATOR_H
+
+#include <stdint.h>
+#include "kit_hal_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#ifndef KIT_EMULATOR_DEVICES
+#define KIT_EMULATOR_DEVICES        (8)     //! The maximum number of emulated devices
+#endif // KIT_EMULATOR_DEVICES
+
+#ifndef KIT_EMULATOR_OVERRIDES
+#define KIT_EMULATOR_OVERRIDES      (8)     //! The maximum number of configured execution times
+#endif // KIT_EMULATOR_OVERRIDES
+
+#ifndef KIT_EMULATOR_BYTE_TIME_US
+#define KIT_EMULATOR_BYTE_TIME_US   (10)    //! The simulated bus time of each transferred byte, in microseconds
+#endif // KIT_EMULATOR_BYTE_TIME_US
+
+#ifndef KIT_EMULATOR_CLOCK_READ_US
+#define KIT_EMULATOR_CLOCK_READ_US  (1)     //! The simulated time of a clock read, so the polling loops end
+#endif // KIT_EMULATOR_CLOCK_READ_US
+
+struct kit_emulator_stats
+{
+    uint32_t wakes;        //!< The wake tokens sent to a sleeping device
+    uint32_t commands;     //!< The command packets accepted
+    uint32_t crc_errors;   //!< The command packets rejected for their CRC or their framing
+    uint32_t busy_polls;   //!< The receives refused while a device was asleep or busy
+    uint64_t bus_time_us;  //!< The simulated bus time of all the transfers
+};
+
+/** \brief Removes all the emulated devices, including the default ECC608B (I2C C0),
+ *         ECC204 (I2C 66) and TA100 (I2C 2E) ones.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_emulator_clear_devices(void);
+
+/** \brief Adds an emulated device, it is found by the next hardware_interface_discover.
+ *
+ *  \param[in]    bus_type               The device interface
+ *                device_type            The device type, the ECC, ECC204 and TA10x families
+ *                                       are emulated
+ *                address                The device I2C address or selector byte
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, KIT_STATUS_SMALL_BUFFER when there is no room
+ *          left, otherwise KIT_STATUS_INVALID_PARAM
+ */
+enum kit_protocol_status kit_emulator_add_device(interface_id_t bus_type, device_type_t device_type, uint8_t address);
+
+/** \brief Sets the execution time of a command, in place of the execution time of the
+ *         device tables (get_device_execution_time).
+ *
+ *  \param[in]    device_type            The device type
+ *                opcode                 The command opcode
+ *                time_us                The execution time, in microseconds
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise KIT_STATUS_SMALL_BUFFER
+ */
+enum kit_protocol_status kit_emulator_set_execution_time(device_type_t device_type, uint8_t opcode, uint32_t time_us);
+
+/** \brief Resets the simulated clock, the device states and the statistics; the
+ *         devices and the execution times are kept.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_emulator_reset(void);
+
+/** \brief Returns the simulated clock.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the simulated time, in microseconds
+ */
+uint64_t kit_emulator_get_time_us(void);
+
+/** \brief Returns the emulator statistics, since the last kit_emulator_reset.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the emulator statistics
+ */
+const struct kit_emulator_stats *kit_emulator_get_stats(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // KIT_HAL_EMULATOR_H
@@ -0,0 +1,781 @@
+/**
+ * \file
+ *
+ * \brief  Linux i2c-dev and spidev HAL
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+#ifdef KIT_HAL_LINUX
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L   // nanosleep and clock_gettime, also with -std=c99
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <linux/spi/spidev.h>
+#include "kit_hal_linux.h"
+#include "kit_protocol/kit_protocol_api.h"
+#include "utilities/crc/crc_engines.h"
+
+// The word address of the ECC I2C transfers
+#define KIT_LINUX_I2C_WORD_SLEEP      ((uint8_t)0x01)
+#define KIT_LINUX_I2C_WORD_IDLE       ((uint8_t)0x02)
+#define KIT_LINUX_I2C_WORD_COMMAND    ((uint8_t)0x03)
+
+#define KIT_LINUX_I2C_ADDRESS_MAX     (0xEE)        // The last 8 bits address probed by the discovery
+#define KIT_LINUX_I2C_PACKET_SIZE     (256)         // The largest count byte framed packet, with its word address
+#define KIT_LINUX_WAKE_DELAY_US       (1500)        // The wake delay of the discovery, the longest of the ECC families
+#define KIT_LINUX_INFO_DELAY_US       (5000)        // The Info command execution time of the discovery
+#define KIT_LINUX_TA_REVISION_SIZE    (8)
+
+struct kit_linux_declared_device
+{
+    interface_id_t bus_type;
+    device_type_t device_type;
+    uint8_t address;
+};
+
+static const char *g_kit_linux_i2c_path = KIT_LINUX_I2C_DEVICE;
+static const char *g_kit_linux_spi_path = KIT_LINUX_SPI_DEVICE;
+static struct kit_linux_declared_device g_kit_linux_declared[KIT_LINUX_DECLARED_DEVICES];
+static uint8_t g_kit_linux_declared_count;
+
+void kit_hal_linux_set_i2c_device(const char *path)
+{
+    g_kit_linux_i2c_path = path;
+}
+
+void kit_hal_linux_set_spi_device(const char *path)
+{
+    g_kit_linux_spi_path = path;
+}
+
+enum kit_protocol_status kit_hal_linux_declare_device(interface_id_t bus_type, device_type_t device_type, uint8_t address)
+{
+    if (((bus_type != DEVKIT_IF_I2C) && (bus_type != DEVKIT_IF_SPI)) || (device_type == DEVICE_TYPE_UNKNOWN))
+    {
+        return KIT_STATUS_INVALID_PARAM;
+    }
+
+    if (g_kit_linux_declared_count >= KIT_LINUX_DECLARED_DEVICES)
+    {
+        return KIT_STATUS_SMALL_BUFFER;
+    }
+
+    g_kit_linux_declared[g_kit_linux_declared_count].bus_type = bus_type;
+    g_kit_linux_declared[g_kit_linux_declared_count].device_type = device_type;
+    g_kit_linux_declared[g_kit_linux_declared_count].address = address;
+    g_kit_linux_declared_count++;
+
+    return KIT_STATUS_SUCCESS;
+}
+
+void kit_delay_ms(uint32_t delay_in_ms)
+{
+    struct timespec delay = {(time_t)(delay_in_ms / 1000), (long)(delay_in_ms % 1000) * 1000000L};
+
+    while ((nanosleep(&delay, &delay) != 0) && (errno == EINTR))
+    {
+    }
+}
+
+#ifdef KIT_HAL_DELAY_US
+void kit_delay_us(uint32_t delay_in_us)
+{
+    struct timespec delay = {(time_t)(delay_in_us / 1000000), (long)(delay_in_us % 1000000) * 1000L};
+
+    while ((nanosleep(&delay, &delay) != 0) && (errno == EINTR))
+    {
+    }
+}
+#endif // KIT_HAL_DELAY_US
+
+#ifdef KIT_HAL_TIMER
+uint32_t kit_get_time_ms(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)(((uint64_t)now.tv_sec * 1000u) + ((uint64_t)now.tv_nsec / 1000000u));
+}
+#endif // KIT_HAL_TIMER
+
+/** \brief Returns the monotonic clock in microseconds.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The current time, in microseconds
+ */
+static uint64_t kit_linux_get_time_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000u) + ((uint64_t)now.tv_nsec / 1000u);
+}
+
+/** \brief Returns the total length of a response from its header, the count byte or
+ *         the TA10x length field.
+ *
+ *  \param[in]    is_ta                  Whether the response is TA10x framed
+ *                response               The response header
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return the response length
+ */
+static uint16_t kit_linux_response_length(bool is_ta, const uint8_t *response)
+{
+    return is_ta ? (uint16_t)((response[0] << 8) | response[1]) : response[0];
+}
+
+/** \brief Sends a command and polls its response until the talk timeout.
+ *
+ *  \param[in]    address                The device address
+ *                send                   The send function of the bus
+ *                receive                The receive function of the bus
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] message                As input, the command packet
+ *                                       As output, the response packet, the parser message
+ *                                       buffers hold KIT_MESSAGE_SIZE_MAX bytes
+ *                length                 As input, the length of the command packet
+ *                                       As output, the length of the response packet
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+static enum kit_protocol_status kit_linux_talk(uint32_t address,
+                                               enum kit_protocol_status (*send)(uint32_t, uint8_t *, uint16_t *),
+                                               enum kit_protocol_status (*receive)(uint32_t, uint8_t *, uint16_t *),
+                                               uint8_t *message, uint16_t *length)
+{
+    enum kit_protocol_status status;
+    uint64_t start_time;
+
+    if ((status = send(address, message, length)) != KIT_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    // The delays are rounded up without KIT_HAL_DELAY_US, the timeout is measured
+    start_time = kit_linux_get_time_us();
+    do
+    {
+        kit_delay_us(KIT_LINUX_POLL_US);
+        *length = KIT_MESSAGE_SIZE_MAX;
+        status = receive(address, message, length);
+    } while ((status == KIT_STATUS_RX_NO_RESPONSE) &&
+             ((kit_linux_get_time_us() - start_time) < (KIT_LINUX_TALK_TIMEOUT_MS * 1000UL)));
+
+    if (status != KIT_STATUS_SUCCESS)
+    {
+        *length = 0;
+    }
+
+    return status;
+}
+
+/** \brief Reports the declared devices of a bus.
+ *
+ *  \param[in]    bus_type               The interface
+ *
+ *  \param[out]   device_info            The declared devices
+ *                device_count           The number of declared devices
+ *
+ *  \param[inout] None
+ *
+ *  \return true when there are declared devices on the bus
+ */
+static bool kit_linux_discover_declared(interface_id_t bus_type, device_info_t *device_info, uint8_t *device_count)
+{
+    uint8_t index;
+
+    for (index = 0; index < g_kit_linux_declared_count; index++)
+    {
+        if (g_kit_linux_declared[index].bus_type != bus_type)
+        {
+            continue;
+        }
+
+        memset(&device_info[*device_count], 0, sizeof(device_info[*device_count]));
+        device_info[*device_count].bus_type = bus_type;
+        device_info[*device_count].device_type = g_kit_linux_declared[index].device_type;
+        device_info[*device_count].address = g_kit_linux_declared[index].address;
+        device_info[*device_count].device_index = *device_count;
+        (*device_count)++;
+    }
+
+    return (*device_count != 0);
+}
+
+#ifdef KIT_HAL_I2C
+static int g_kit_linux_i2c_fd = -1;
+static bool g_kit_linux_i2c_smbus;                   // The adapter only has SMBus transfers
+static uint8_t g_kit_linux_i2c_expected[128];        // The expected response size of each 7 bits address, 0 when unknown
+static const uint8_t g_kit_linux_wake_response[] = {0x04, 0x11, 0x33, 0x43};
+
+/** \brief Returns whether a discovered device is a TA10x one.
+ *
+ *  \param[in]    address                The device address
+ *                bus_type               The device interface
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return true for the TA10x devices
+ */
+static bool kit_linux_is_ta(uint32_t address, interface_id_t bus_type)
+{
+    const device_info_t *device = get_device_info_by_address(address, bus_type);
+
+    return (device != NULL) ? check_ta_device(device->device_type) : (bus_type == DEVKIT_IF_SPI);
+}
+
+/** \brief Runs a write and a read, each optional, in a single I2C_RDWR transaction
+ *         (the read follows the write with a repeated start).
+ *
+ *  \param[in]    address                The device address (8 bits)
+ *                tx                     The bytes to write
+ *                tx_length              The number of bytes to write
+ *                rx_length              The number of bytes to read
+ *
+ *  \param[out]   rx                     The bytes read
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, KIT_STATUS_TX_FAIL or KIT_STATUS_RX_NO_RESPONSE
+ *          when the device did not acknowledge
+ */
+static enum kit_protocol_status kit_linux_i2c_transfer(uint8_t address, const uint8_t *tx, uint16_t tx_length,
+                                                       uint8_t *rx, uint16_t rx_length)
+{
+    struct i2c_msg messages[2];
+    struct i2c_rdwr_ioctl_data transfer = {messages, 0};
+
+    if (tx_length != 0)
+    {
+        messages[transfer.nmsgs].addr = (uint16_t)(address >> 1);
+        messages[transfer.nmsgs].flags = 0;
+        messages[transfer.nmsgs].len = tx_length;
+        messages[transfer.nmsgs].buf = (uint8_t *)tx;
+        transfer.nmsgs++;
+    }
+
+    if (rx_length != 0)
+    {
+        messages[transfer.nmsgs].addr = (uint16_t)(address >> 1);
+        messages[transfer.nmsgs].flags = I2C_M_RD;
+        messages[transfer.nmsgs].len = rx_length;
+        messages[transfer.nmsgs].buf = rx;
+        transfer.nmsgs++;
+    }
+
+    if ((g_kit_linux_i2c_fd < 0) || (ioctl(g_kit_linux_i2c_fd, I2C_RDWR, &transfer) < 0))
+    {
+        return (rx_length != 0) ? KIT_STATUS_RX_NO_RESPONSE : KIT_STATUS_TX_FAIL;
+    }
+
+    return KIT_STATUS_SUCCESS;
+}
+
+/** \brief Runs an SMBus transfer, for the adapters without plain I2C transfers.
+ *
+ *  \param[in]    address                The device address (8 bits)
+ *                read_write             I2C_SMBUS_READ or I2C_SMBUS_WRITE
+ *                command                The register (the word address)
+ *                size                   The SMBus transfer type
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] data                   The transfer data
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise KIT_STATUS_COMM_FAIL
+ */
+static enum kit_protocol_status kit_linux_smbus_transfer(uint8_t address, uint8_t read_write, uint8_t command, uint32_t size,
+                                                         union i2c_smbus_data *data)
+{
+    struct i2c_smbus_ioctl_data transfer = {read_write, command, size, data};
+
+    if ((g_kit_linux_i2c_fd < 0) || (ioctl(g_kit_linux_i2c_fd, I2C_SLAVE, (unsigned long)(address >> 1)) < 0) ||
+        (ioctl(g_kit_linux_i2c_fd, I2C_SMBUS, &transfer) < 0))
+    {
+        return KIT_STATUS_COMM_FAIL;
+    }
+
+    return KIT_STATUS_SUCCESS;
+}
+
+/** \brief Writes a word address to an I2C device, the idle and sleep tokens.
+ *
+ *  \param[in]    address                The device address (8 bits)
+ *                word_address           The word address
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise an error code
+ */
+static enum kit_protocol_status kit_linux_i2c_write_word(uint8_t address, uint8_t word_address)
+{
+    if (g_kit_linux_i2c_smbus)
+    {
+        return kit_linux_smbus_transfer(address, I2C_SMBUS_WRITE, word_address, I2C_SMBUS_BYTE, NULL);
+    }
+
+    return kit_linux_i2c_transfer(address, &word_address, sizeof(word_address), NULL, 0);
+}
+
+void hal_i2c_init(void)
+{
+    unsigned long functions = 0;
+
+    if (g_kit_linux_i2c_fd >= 0)
+    {
+        return;
+    }
+
+    if ((g_kit_linux_i2c_fd = open(g_kit_linux_i2c_path, O_RDWR)) < 0)
+    {
+        printf("%s: %s\r\n", g_kit_linux_i2c_path, strerror(errno));
+        return;
+    }
+
+    g_kit_linux_i2c_smbus = (ioctl(g_kit_linux_i2c_fd, I2C_FUNCS, &functions) < 0) || !(functions & I2C_FUNC_I2C);
+    memset(g_kit_linux_i2c_expected, 0, sizeof(g_kit_linux_i2c_expected));
+}
+
+void hal_i2c_deinit(void)
+{
+    if (g_kit_linux_i2c_fd >= 0)
+    {
+        close(g_kit_linux_i2c_fd);
+        g_kit_linux_i2c_fd = -1;
+    }
+}
+
+enum kit_protocol_status hal_i2c_wake(uint32_t address)
+{
+    uint8_t wake = 0x00;
+
+    (void)address;
+
+    // The address 0 byte holds SDA low long enough at 100 kHz, nothing acknowledges it
+    if (g_kit_linux_i2c_smbus)
+    {
+        (void)kit_linux_smbus_transfer(0x00, I2C_SMBUS_WRITE, 0, I2C_SMBUS_QUICK, NULL);
+    }
+    else
+    {
+        (void)kit_linux_i2c_transfer(0x00, &wake, sizeof(wake), NULL, 0);
+    }
+
+    return KIT_STATUS_SUCCESS;
+}
+
+enum kit_protocol_status hal_i2c_idle(uint32_t address)
+{
+    return kit_linux_i2c_write_word((uint8_t)address, KIT_LINUX_I2C_WORD_IDLE);
+}
+
+enum kit_protocol_status hal_i2c_sleep(uint32_t address)
+{
+    return kit_linux_i2c_write_word((uint8_t)address, KIT_LINUX_I2C_WORD_SLEEP);
+}
+
+enum kit_protocol_status hal_i2c_send(uint32_t address, uint8_t *message, uint16_t *length)
+{
+    const device_info_t *device = get_device_info_by_address(address, DEVKIT_IF_I2C);
+    union i2c_smbus_data data;
+    uint8_t packet[KIT_LINUX_I2C_PACKET_SIZE + 1];
+
+    // The response size is known from the command, its read then takes a single transfer
+    g_kit_linux_i2c_expected[(uint8_t)address >> 1] = 0;
+    if ((device != NULL) && (*length > ECC108_PARAM1_IDX) && (device->device_type >= DEVICE_TYPE_ECC108) &&
+        (device->device_type <= DEVICE_TYPE_ECC608B) && (device->device_type != DEVICE_TYPE_SHA206A))
+    {
+        g_kit_linux_i2c_expected[(uint8_t)address >> 1] = get_eccx08_response_size(message);
+    }
+
+    if (g_kit_linux_i2c_smbus)
+    {
+        if (*length > I2C_SMBUS_BLOCK_MAX)
+        {
+            return KIT_STATUS_INVALID_SIZE;
+        }
+
+        data.block[0] = (uint8_t)*length;
+        memcpy(&data.block[1], message, *length);
+        return kit_linux_smbus_transfer((uint8_t)address, I2C_SMBUS_WRITE, KIT_LINUX_I2C_WORD_COMMAND,
+                                        I2C_SMBUS_I2C_BLOCK_DATA, &data);
+    }
+
+    if (*length > KIT_LINUX_I2C_PACKET_SIZE)
+    {
+        return KIT_STATUS_INVALID_SIZE;
+    }
+
+    // The word address and the packet go in one write
+    packet[0] = KIT_LINUX_I2C_WORD_COMMAND;
+    memcpy(&packet[1], message, *length);
+
+    return kit_linux_i2c_transfer((uint8_t)address, packet, (uint16_t)(*length + 1), NULL, 0);
+}
+
+enum kit_protocol_status hal_i2c_receive(uint32_t address, uint8_t *message, uint16_t *length)
+{
+    enum kit_protocol_status status;
+    const bool is_ta = kit_linux_is_ta(address, DEVKIT_IF_I2C);
+    const uint16_t header_size = is_ta ? 2 : 1;
+    const uint8_t expected = g_kit_linux_i2c_expected[(uint8_t)address >> 1];
+    union i2c_smbus_data data;
+    uint16_t read_length;
+    uint16_t response_length;
+
+    if (*length < header_size)
+    {
+        return KIT_STATUS_INVALID_SIZE;
+    }
+
+    if (g_kit_linux_i2c_smbus)
+    {
+        data.block[0] = (uint8_t)((*length < I2C_SMBUS_BLOCK_MAX) ? *length : I2C_SMBUS_BLOCK_MAX);
+        if ((status = kit_linux_smbus_transfer((uint8_t)address, I2C_SMBUS_READ, KIT_LINUX_I2C_WORD_COMMAND,
+                                               I2C_SMBUS_I2C_BLOCK_DATA, &data)) != KIT_STATUS_SUCCESS)
+        {
+            return KIT_STATUS_RX_NO_RESPONSE;
+        }
+        read_length = data.block[0];
+        memcpy(message, &data.block[1], read_length);
+    }
+    else
+    {
+        // The expected response is read at once, otherwise its header first
+        read_length = ((expected != 0) && (expected <= *length)) ? expected : (is_ta ? header_size : ECC108_RSP_SIZE_MIN);
+        read_length = (read_length <= *length) ? read_length : *length;
+        if ((status = kit_linux_i2c_transfer((uint8_t)address, NULL, 0, message, read_length)) != KIT_STATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    response_length = kit_linux_response_length(is_ta, message);
+    if ((response_length < header_size) || (response_length > *length))
+    {
+        *length = 0;
+        return KIT_STATUS_RX_FAIL;
+    }
+
+    if (response_length > read_length)
+    {
+        if (g_kit_linux_i2c_smbus)
+        {
+            *length = 0;
+            return KIT_STATUS_INVALID_SIZE;
+        }
+
+        // The rest of a response longer than expected
+        if ((status = kit_linux_i2c_transfer((uint8_t)address, NULL, 0, &message[read_length],
+                                             (uint16_t)(response_length - read_length))) != KIT_STATUS_SUCCESS)
+        {
+            *length = 0;
+            return status;
+        }
+    }
+
+    g_kit_linux_i2c_expected[(uint8_t)address >> 1] = 0;
+    *length = response_length;
+
+    return KIT_STATUS_SUCCESS;
+}
+
+enum kit_protocol_status hal_i2c_talk(uint32_t address, uint8_t *message, uint16_t *length)
+{
+    return kit_linux_talk(address, hal_i2c_send, hal_i2c_receive, message, length);
+}
+
+void hal_i2c_discover(device_info_t *device_info, uint8_t *device_count)
+{
+    // <count><opcode><mode><param2:2><crc:2>, Info revision
+    uint8_t info_command[7] = {0x07, ECC108_INFO, 0x00, 0x00, 0x00};
+    uint8_t response[INFO_RSP_SIZE];
+    uint16_t length;
+    uint16_t address;
+
+    *device_count = 0;
+
+    if ((g_kit_linux_i2c_fd < 0) || kit_linux_discover_declared(DEVKIT_IF_I2C, device_info, device_count))
+    {
+        return;
+    }
+
+    calculate_sha_ecc_crc((uint8_t)(sizeof(info_command) - 2), info_command, &info_command[sizeof(info_command) - 2]);
+
+    // One wake reaches all the devices, then each address answers with its wake response
+    (void)hal_i2c_wake(0);
+    kit_delay_us(KIT_LINUX_WAKE_DELAY_US);
+
+    for (address = 0x02; (address <= KIT_LINUX_I2C_ADDRESS_MAX) && (*device_count < MAX_DISCOVER_DEVICES); address += 2)
+    {
+        if ((kit_linux_i2c_transfer((uint8_t)address, NULL, 0, response, sizeof(g_kit_linux_wake_response)) != KIT_STATUS_SUCCESS) ||
+            (memcmp(response, g_kit_linux_wake_response, sizeof(g_kit_linux_wake_response)) != 0))
+        {
+            continue;
+        }
+
+        // The Info command returns the device revision
+        length = sizeof(info_command);
+        (void)hal_i2c_send(address, info_command, &length);
+        kit_delay_us(KIT_LINUX_INFO_DELAY_US);
+        if ((kit_linux_i2c_transfer((uint8_t)address, NULL, 0, response, sizeof(response)) == KIT_STATUS_SUCCESS) &&
+            (response[0] == sizeof(response)) && check_sha_ecc_crc(response))
+        {
+            memset(&device_info[*device_count], 0, sizeof(device_info[*device_count]));
+            device_info[*device_count].bus_type = DEVKIT_IF_I2C;
+            device_info[*device_count].device_type = sha_ecc_device_type(&response[1]);
+            device_info[*device_count].address = (uint8_t)address;
+            device_info[*device_count].device_index = *device_count;
+            memcpy(device_info[*device_count].dev_rev, &response[1], 4);
+            (*device_count)++;
+        }
+
+        (void)hal_i2c_sleep(address);
+    }
+}
+
+#endif // KIT_HAL_I2C
+
+#ifdef KIT_HAL_SPI
+static int g_kit_linux_spi_fd = -1;
+
+/** \brief Runs a write and a read, each optional, in a single spidev message with the
+ *         chip select held across both.
+ *
+ *  \param[in]    tx                     The bytes to write
+ *                tx_length              The number of bytes to write
+ *                rx_length              The number of bytes to read
+ *
+ *  \param[out]   rx                     The bytes read
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, otherwise KIT_STATUS_COMM_FAIL
+ */
+static enum kit_protocol_status kit_linux_spi_transfer(const uint8_t *tx, uint16_t tx_length, uint8_t *rx, uint16_t rx_length)
+{
+    struct spi_ioc_transfer transfers[2];
+    unsigned int count = 0;
+
+    memset(transfers, 0, sizeof(transfers));
+
+    if (tx_length != 0)
+    {
+        transfers[count].tx_buf = (unsigned long)tx;
+        transfers[count].len = tx_length;
+        transfers[count].speed_hz = KIT_LINUX_SPI_SPEED_HZ;
+        transfers[count].bits_per_word = 8;
+        count++;
+    }
+
+    if (rx_length != 0)
+    {
+        transfers[count].rx_buf = (unsigned long)rx;
+        transfers[count].len = rx_length;
+        transfers[count].speed_hz = KIT_LINUX_SPI_SPEED_HZ;
+        transfers[count].bits_per_word = 8;
+        count++;
+    }
+
+    if ((g_kit_linux_spi_fd < 0) || (ioctl(g_kit_linux_spi_fd, SPI_IOC_MESSAGE(count), transfers) < 0))
+    {
+        return KIT_STATUS_COMM_FAIL;
+    }
+
+    return KIT_STATUS_SUCCESS;
+}
+
+void hal_spi_init(void)
+{
+    uint8_t mode = SPI_MODE_0;
+    uint8_t bits = 8;
+    uint32_t speed = KIT_LINUX_SPI_SPEED_HZ;
+
+    if (g_kit_linux_spi_fd >= 0)
+    {
+        return;
+    }
+
+    if ((g_kit_linux_spi_fd = open(g_kit_linux_spi_path, O_RDWR)) < 0)
+    {
+        printf("%s: %s\r\n", g_kit_linux_spi_path, strerror(errno));
+        return;
+    }
+
+    if ((ioctl(g_kit_linux_spi_fd, SPI_IOC_WR_MODE, &mode) < 0) || (ioctl(g_kit_linux_spi_fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0) ||
+        (ioctl(g_kit_linux_spi_fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed) < 0))
+    {
+        printf("%s: %s\r\n", g_kit_linux_spi_path, strerror(errno));
+    }
+}
+
+void hal_spi_deinit(void)
+{
+    if (g_kit_linux_spi_fd >= 0)
+    {
+        close(g_kit_linux_spi_fd);
+        g_kit_linux_spi_fd = -1;
+    }
+}
+
+enum kit_protocol_status hal_spi_wake(uint32_t address)
+{
+    // The TA10x devices are awake while powered
+    (void)address;
+    return KIT_STATUS_SUCCESS;
+}
+
+enum kit_protocol_status hal_spi_idle(uint32_t address)
+{
+    (void)address;
+    return KIT_STATUS_SUCCESS;
+}
+
+enum kit_protocol_status hal_spi_sleep(uint32_t address)
+{
+    (void)address;
+    return KIT_STATUS_SUCCESS;
+}
+
+enum kit_protocol_status hal_spi_send(uint32_t address, uint8_t *message, uint16_t *length)
+{
+    (void)address;
+
+    // The host packets start with their instruction byte
+    return kit_linux_spi_transfer(message, *length, NULL, 0);
+}
+
+enum kit_protocol_status hal_spi_receive(uint32_t address, uint8_t *message, uint16_t *length)
+{
+    static const uint8_t read_instruction = KIT_LINUX_SPI_READ_INSTRUCTION;
+    enum kit_protocol_status status;
+    uint16_t response_length;
+
+    (void)address;
+
+    if (*length < 2)
+    {
+        return KIT_STATUS_INVALID_SIZE;
+    }
+
+    // The instruction and the whole response in one message, the SPI clock makes the extra bytes cheap
+    if ((status = kit_linux_spi_transfer(&read_instruction, sizeof(read_instruction), message, *length)) != KIT_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    // A busy device answers an invalid length
+    response_length = kit_linux_response_length(true, message);
+    if ((response_length < 2) || (response_length == UINT16_MAX))
+    {
+        *length = 0;
+        return KIT_STATUS_RX_NO_RESPONSE;
+    }
+
+    if (response_length > *length)
+    {
+        *length = 0;
+        return KIT_STATUS_SMALL_BUFFER;
+    }
+
+    *length = response_length;
+
+    return KIT_STATUS_SUCCESS;
+}
+
+enum kit_protocol_status hal_spi_talk(uint32_t address, uint8_t *message, uint16_t *length)
+{
+    return kit_linux_talk(address, hal_spi_send, hal_spi_receive, message, length);
+}
+
+void hal_spi_discover(device_info_t *device_info, uint8_t *device_count)
+{
+    // <instruction><length:2><opcode><mode><param1:2><param2:4><crc:2>, Info revision
+    uint8_t info_command[13] = {KIT_LINUX_SPI_WRITE_INSTRUCTION, 0x00, 0x0C, ATCA_TA_INFO};
+    uint8_t response[2 + 1 + KIT_LINUX_TA_REVISION_SIZE + 2];
+    uint16_t length;
+    uint16_t crc;
+
+    *device_count = 0;
+
+    if ((g_kit_linux_spi_fd < 0) || kit_linux_discover_declared(DEVKIT_IF_SPI, device_info, device_count))
+    {
+        return;
+    }
+
+    calc_ta_crc((uint16_t)(sizeof(info_command) - 3), &info_command[1], &crc);
+    info_command[sizeof(info_command) - 2] = (uint8_t)(crc >> 8);
+    info_command[sizeof(info_command) - 1] = (uint8_t)crc;
+
+    if (kit_linux_spi_transfer(info_command, sizeof(info_command), NULL, 0) != KIT_STATUS_SUCCESS)
+    {
+        return;
+    }
+    kit_delay_us(KIT_LINUX_INFO_DELAY_US);
+
+    length = sizeof(response);
+    if ((hal_spi_receive(0, response, &length) == KIT_STATUS_SUCCESS) && (length == sizeof(response)) &&
+        (response[2] == 0x00) && check_ta_crc(response, (uint16_t)(length - 2)))
+    {
+        memset(&device_info[0], 0, sizeof(device_info[0]));
+        device_info[0].bus_type = DEVKIT_IF_SPI;
+        device_info[0].device_type = ta10x_device_type(&response[3]);
+        device_info[0].address = 0x00;
+        memcpy(device_info[0].dev_rev, &response[3], KIT_LINUX_TA_REVISION_SIZE);
+        *device_count = 1;
+    }
+}
+#endif // KIT_HAL_SPI
+
+#endif // KIT_HAL_LINUX
@@ -0,0 +1,130 @@
+/**
+ * \file
+ *
+ * \brief  Linux i2c-dev and spidev HAL
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*
+ * Linux HAL backend, it provides hal_i2c_*() on an i2c-dev node and hal_spi_*()
+ * on a spidev node, with kit_delay_ms(), kit_delay_us() and kit_get_time_ms().
+ * Build it in place of the platform HAL with -DKIT_HAL_LINUX.
+ *
+ * The adapters without plain I2C transfers (Ex. the i2c-stub module) are driven
+ * with SMBus I2C block transfers: a packet written to a register reads back
+ * from it, so the parser can be run in loopback with no hardware.
+ */
+
+#ifndef KIT_HAL_LINUX_H
+#define KIT_HAL_LINUX_H
+
+#include <stdint.h>
+#include "kit_hal_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#ifndef KIT_LINUX_I2C_DEVICE
+#define KIT_LINUX_I2C_DEVICE           "/dev/i2c-1"       //! The default I2C adapter node
+#endif // KIT_LINUX_I2C_DEVICE
+
+#ifndef KIT_LINUX_SPI_DEVICE
+#define KIT_LINUX_SPI_DEVICE           "/dev/spidev0.0"   //! The default SPI device node
+#endif // KIT_LINUX_SPI_DEVICE
+
+#ifndef KIT_LINUX_SPI_SPEED_HZ
+#define KIT_LINUX_SPI_SPEED_HZ         (4000000)          //! The SPI clock
+#endif // KIT_LINUX_SPI_SPEED_HZ
+
+#ifndef KIT_LINUX_SPI_WRITE_INSTRUCTION
+#define KIT_LINUX_SPI_WRITE_INSTRUCTION ((uint8_t)0x02)   //! The first byte of the TA10x packets written on SPI (discovery only,
+                                                          //! the host packets hold their own)
+#endif // KIT_LINUX_SPI_WRITE_INSTRUCTION
+
+#ifndef KIT_LINUX_SPI_READ_INSTRUCTION
+#define KIT_LINUX_SPI_READ_INSTRUCTION ((uint8_t)0x03)    //! The byte sent ahead of a TA10x response read on SPI
+#endif // KIT_LINUX_SPI_READ_INSTRUCTION
+
+#ifndef KIT_LINUX_POLL_US
+#define KIT_LINUX_POLL_US              (500)              //! The response polling interval of a talk
+#endif // KIT_LINUX_POLL_US
+
+#ifndef KIT_LINUX_TALK_TIMEOUT_MS
+#define KIT_LINUX_TALK_TIMEOUT_MS      (2000)             //! The longest time a talk polls its response
+#endif // KIT_LINUX_TALK_TIMEOUT_MS
+
+#ifndef KIT_LINUX_DECLARED_DEVICES
+#define KIT_LINUX_DECLARED_DEVICES     (4)                //! The maximum number of declared devices
+#endif // KIT_LINUX_DECLARED_DEVICES
+
+/** \brief Sets the I2C adapter node, before hardware_interface_discover.
+ *
+ *  \param[in]    path                   The node path (Ex. /dev/i2c-1)
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_hal_linux_set_i2c_device(const char *path);
+
+/** \brief Sets the SPI device node, before hardware_interface_discover.
+ *
+ *  \param[in]    path                   The node path (Ex. /dev/spidev0.0)
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return None
+ */
+void kit_hal_linux_set_spi_device(const char *path);
+
+/** \brief Declares a device, the discovery of its bus then reports the declared
+ *         devices without probing the bus (Ex. the i2c-stub chips).
+ *
+ *  \param[in]    bus_type               The device interface, DEVKIT_IF_I2C or DEVKIT_IF_SPI
+ *                device_type            The device type
+ *                address                The device I2C address (8 bits), 0 on SPI
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return KIT_STATUS_SUCCESS on success, KIT_STATUS_SMALL_BUFFER when there is no room
+ *          left, otherwise KIT_STATUS_INVALID_PARAM
+ */
+enum kit_protocol_status kit_hal_linux_declare_device(interface_id_t bus_type, device_type_t device_type, uint8_t address);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // KIT_HAL_LINUX_H
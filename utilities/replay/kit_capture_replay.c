@@ -0,0 +1,284 @@
+/**
+ * \file
+ *
+ * \brief  Replays a KIT protocol binary traffic capture
+ *
+ * \copyright (c) 2018 Microchip Technology Inc. and its subsidiaries.
+ *            You may use this software and any derivatives exclusively with
+ *            Microchip products.
+ *
+ * \page License
+ *
+ * (c) 2018 Microchip Technology Inc. and its subsidiaries. You may use this
+ * software and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIPS TOTAL LIABILITY ON ALL CLAIMS IN
+ * ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*
+ * Host side tool, it runs the host messages of a capture (kit_capture_start)
+ * through the interpreter at full speed and reports, for each message, the
+ * captured latency, the replay latency and whether the response matches.
+ *
+ * Build it on Linux with the parser sources, a HAL and -DKIT_CAPTURE_REPLAY.
+ */
+#ifdef KIT_CAPTURE_REPLAY
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L   // clock_gettime, also with -std=c99
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "kit_protocol_api.h"
+#include "kit_protocol_capture.h"
+#include "kit_protocol_init.h"
+#include "kit_protocol_interpreter.h"
+#include "kit_hal_interface.h"
+
+#define KIT_REPLAY_NAME_SIZE_MAX  (32)  //! The maximum number of message characters printed
+
+// The message buffer, the responses of a pipelined host buffer follow each other
+static uint8_t g_kit_replay_message[2 * KIT_MESSAGE_SIZE_MAX];
+
+/** \brief Returns the monotonic time.
+ *
+ *  \param[in]    None
+ *
+ *  \param[out]   None
+ *
+ *  \param[inout] None
+ *
+ *  \return The monotonic time, in nanoseconds
+ */
+static uint64_t kit_replay_get_time(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+}
+
+/** \brief Reads a whole capture file.
+ *
+ *  \param[in]    path                   The capture file path
+ *
+ *  \param[out]   length                 The number of capture bytes
+ *
+ *  \param[inout] None
+ *
+ *  \return The capture bytes (to be freed), NULL on failure
+ */
+static uint8_t *kit_replay_read_file(const char *path, uint32_t *length)
+{
+    FILE *file;
+    uint8_t *capture = NULL;
+    long size;
+
+    if (NULL == (file = fopen(path, "rb")))
+    {
+        return NULL;
+    }
+
+    if ((fseek(file, 0, SEEK_END) == 0) && ((size = ftell(file)) > 0) && (fseek(file, 0, SEEK_SET) == 0) &&
+        (NULL != (capture = malloc((size_t)size))))
+    {
+        if (fread(capture, 1, (size_t)size, file) == (size_t)size)
+        {
+            *length = (uint32_t)size;
+        }
+        else
+        {
+            free(capture);
+            capture = NULL;
+        }
+    }
+
+    fclose(file);
+
+    return capture;
+}
+
+/** \brief Runs a received host buffer through the interpreter.
+ *
+ *  \param[in]    record                 The received capture record
+ *
+ *  \param[out]   response_length        The length of the response
+ *
+ *  \param[inout] None
+ *
+ *  \return The replay time, in nanoseconds
+ */
+static uint64_t kit_replay_run(const struct kit_capture_record *record, uint16_t *response_length)
+{
+    struct kit_interpreter_ctx *ctx = kit_interpreter_get_default_ctx();
+    uint16_t message_length;
+    uint16_t index = 0;
+    uint16_t end;
+    uint64_t start_time;
+    uint64_t elapsed = 0;
+
+    *response_length = 0;
+
+    if (record->length > KIT_MESSAGE_SIZE_MAX)
+    {
+        return 0;
+    }
+
+    if (record->flags & KIT_CAPTURE_FLAG_BINARY)
+    {
+        memcpy(g_kit_replay_message, record->data, record->length);
+        message_length = record->length;
+        start_time = kit_replay_get_time();
+        kit_interpreter_handle_binary_ctx(ctx, g_kit_replay_message, &message_length);
+        elapsed = kit_replay_get_time() - start_time;
+        *response_length = message_length;
+        return elapsed;
+    }
+
+    // A pipelined host buffer holds several messages, their responses are concatenated
+    while (index < record->length)
+    {
+        for (end = index; (end < record->length) && (record->data[end] != KIT_MESSAGE_DELIMITER); end++)
+        {
+        }
+
+        message_length = (uint16_t)(((end < record->length) ? (end + 1) : end) - index);
+        if (((size_t)*response_length + KIT_MESSAGE_SIZE_MAX) > sizeof(g_kit_replay_message))
+        {
+            break;
+        }
+
+        // The response of the message replaces the message, after the previous responses
+        memcpy(&g_kit_replay_message[*response_length], &record->data[index], message_length);
+        start_time = kit_replay_get_time();
+        kit_interpreter_handle_message((char *)&g_kit_replay_message[*response_length], &message_length);
+        elapsed += kit_replay_get_time() - start_time;
+        *response_length += message_length;
+        index = end + 1;
+    }
+
+    return elapsed;
+}
+
+int main(int argc, char *argv[])
+{
+    struct kit_capture_header header;
+    struct kit_capture_record record;
+    struct kit_capture_record received = {0};
+    uint8_t *capture;
+    uint32_t capture_length = 0;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t messages = 0;
+    uint32_t mismatches = 0;
+    uint64_t replay_time = 0;
+    uint64_t captured_time;
+    uint64_t captured_total = 0;
+    uint64_t replay_total = 0;
+    uint16_t response_length = 0;
+    bool pending = false;
+    bool same;
+    int name_length;
+
+    if (argc != 2)
+    {
+        printf("Usage: %s <capture file>\r\n", argv[0]);
+        return 1;
+    }
+
+    if (NULL == (capture = kit_replay_read_file(argv[1], &capture_length)))
+    {
+        printf("Cannot read %s\r\n", argv[1]);
+        return 1;
+    }
+
+    if (0 == (offset = kit_capture_read_header(capture, capture_length, &header)))
+    {
+        printf("%s is not a supported capture\r\n", argv[1]);
+        free(capture);
+        return 1;
+    }
+
+    kit_protocol_init();
+    hardware_interface_discover();
+
+    printf("%-*s %12s %12s %s\r\n", KIT_REPLAY_NAME_SIZE_MAX, "Message", "Captured us", "Replay us", "Response");
+
+    while (0 != (size = kit_capture_read_record(&capture[offset], capture_length - offset, &record)))
+    {
+        offset += size;
+
+        if (record.direction == KIT_TRACE_RECEIVED)
+        {
+            received = record;
+            replay_time = kit_replay_run(&record, &response_length);
+            pending = true;
+        }
+        else if ((record.direction == KIT_TRACE_SENT) && pending)
+        {
+            pending = false;
+            messages++;
+
+            captured_time = ((uint64_t)(uint32_t)(record.timestamp - received.timestamp) * 1000000000u) / header.clock_rate;
+            captured_total += captured_time;
+            replay_total += replay_time;
+
+            same = ((response_length == record.length) && !memcmp(g_kit_replay_message, record.data, record.length));
+            if (!same)
+            {
+                mismatches++;
+            }
+
+            // Print the start of the first message, up to its delimiter
+            for (name_length = 0; (name_length < received.length) && (name_length < KIT_REPLAY_NAME_SIZE_MAX) &&
+                 (received.data[name_length] != KIT_MESSAGE_DELIMITER); name_length++)
+            {
+            }
+
+            if (received.flags & KIT_CAPTURE_FLAG_BINARY)
+            {
+                printf("%-*s", KIT_REPLAY_NAME_SIZE_MAX, "<binary frame>");
+            }
+            else
+            {
+                printf("%-*.*s", KIT_REPLAY_NAME_SIZE_MAX, name_length, (const char *)received.data);
+            }
+
+            printf(" %12.1f %12.1f %s\r\n", captured_time / 1000.0, replay_time / 1000.0,
+                   same ? "same" : "differs");
+        }
+    }
+
+    if (offset != capture_length)
+    {
+        printf("The capture is truncated at offset %lu\r\n", (unsigned long)offset);
+    }
+
+    printf("%lu messages, captured %.1f us, replay %.1f us, %lu responses differ\r\n", (unsigned long)messages,
+           captured_total / 1000.0, replay_total / 1000.0, (unsigned long)mismatches);
+
+    free(capture);
+
+    return (mismatches == 0) ? 0 : 2;
+}
+
+#endif // KIT_CAPTURE_REPLAY